@@ -0,0 +1,203 @@
+#include <benchmark/benchmark.h>
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <vector>
+#include "FourierEngine.h"
+#include "PathData.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include "TrailBuffer.h"
+
+// Microbenchmarks for the per-shape and per-frame hot paths.
+//
+// Write results as JSON and compare against a stored baseline with the
+// compare.py script that ships with Google Benchmark:
+//   fourier-bench --benchmark_out=current.json --benchmark_out_format=json
+//   compare.py benchmarks baseline.json current.json
+
+namespace {
+
+const int TOP_K = 200;               // The most epicycles the visualizer draws
+const int EVALUATION_PATH_SIZE = 4096;
+const double FRAME_STEP = 1.0 / 60.0 * 0.3;  // One frame at the default speed
+
+// Uneven spacing, like a path drawn by hand: fast strokes leave wide gaps
+std::vector<Point2D> makeDrawnPath(int n) {
+    std::vector<Point2D> path(n);
+    double t = 0.0;
+    for (int i = 0; i < n; i++) {
+        t += 0.5 + 0.5 * std::sin(i * 0.05);
+        double angle = t * 2.0 * M_PI / n;
+        float r = 200.f + 40.f * static_cast<float>(std::sin(5.0 * angle));
+        path[i] = Point2D(400.f + r * static_cast<float>(std::cos(angle)),
+                          300.f + r * static_cast<float>(std::sin(angle)));
+    }
+    return path;
+}
+
+template <typename Engine>
+void prepareEngine(Engine& engine, int epicycles, EvaluationMode mode) {
+    engine.setTopK(TOP_K);
+    engine.computeDFT(PathData::createStar(EVALUATION_PATH_SIZE));
+    engine.setNumEpicycles(epicycles);
+    engine.setEvaluationMode(mode);
+}
+
+} // namespace
+
+// Whole per-shape pipeline: FFT, magnitudes, top-K selection, SoA fill
+static void BM_ComputeDFT(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    std::vector<Point2D> path = PathData::createStar(n);
+    FourierEngine engine;
+    engine.setTopK(TOP_K);
+
+    for (auto _ : state) {
+        engine.computeDFT(path);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_ComputeDFT)->RangeMultiplier(4)->Range(256, 1 << 20)
+    ->Unit(benchmark::kMicrosecond)->Complexity(benchmark::oNLogN);
+
+// Per-frame evaluation as the frame loop calls it (caller-owned buffer)
+template <typename Engine = FourierEngine>
+static void getEpicyclesBenchmark(benchmark::State& state, EvaluationMode mode) {
+    int count = static_cast<int>(state.range(0));
+    Engine engine;
+    prepareEngine(engine, count, mode);
+
+    std::vector<Epicycle> epicycles(count);
+    Point2D tip;
+    double t = 0.0;
+    for (auto _ : state) {
+        t += FRAME_STEP;
+        int written = engine.getEpicycles(t, Point2D(640.f, 360.f), epicycles.data(), count, tip);
+        benchmark::DoNotOptimize(written);
+        benchmark::DoNotOptimize(tip);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_GetEpicycles(benchmark::State& state) {
+    getEpicyclesBenchmark(state, EvaluationMode::Phasor);
+}
+BENCHMARK(BM_GetEpicycles)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_GetEpicyclesDirect(benchmark::State& state) {
+    getEpicyclesBenchmark(state, EvaluationMode::Direct);
+}
+BENCHMARK(BM_GetEpicyclesDirect)->RangeMultiplier(4)->Range(16, 4096);
+
+// Same as BM_GetEpicycles with float phasors and terms (the windowed app's default)
+static void BM_GetEpicyclesFloat(benchmark::State& state) {
+    getEpicyclesBenchmark<RealtimeFourierEngine>(state, EvaluationMode::Phasor);
+}
+BENCHMARK(BM_GetEpicyclesFloat)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_GetTracedPoint(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    FourierEngine engine;
+    prepareEngine(engine, count, EvaluationMode::Phasor);
+
+    double t = 0.0;
+    for (auto _ : state) {
+        t += FRAME_STEP;
+        benchmark::DoNotOptimize(engine.getTracedPoint(t));
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_GetTracedPoint)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_ResamplePath(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    std::vector<Point2D> path = makeDrawnPath(n);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PathData::resamplePath(path, n));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetComplexityN(n);
+}
+BENCHMARK(BM_ResamplePath)->RangeMultiplier(8)->Range(512, 1 << 18)
+    ->Unit(benchmark::kMicrosecond)->Complexity();
+
+static void BM_CenterPath(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    std::vector<Point2D> path = makeDrawnPath(n);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PathData::centerPath(path, Point2D(0.f, 0.f)));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CenterPath)->RangeMultiplier(8)->Range(512, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// Renderer geometry for one frame's epicycles and arms, drawn offscreen
+static void BM_RenderEpicycles(benchmark::State& state) {
+    int count = static_cast<int>(state.range(0));
+    sf::RenderTexture canvas;
+    if (!canvas.resize({1280, 720})) {
+        state.SkipWithError("Offscreen render target unavailable");
+        return;
+    }
+
+    FourierEngine engine;
+    prepareEngine(engine, count, EvaluationMode::Phasor);
+    std::vector<Epicycle> epicycles(count);
+    Point2D tip;
+    epicycles.resize(engine.getEpicycles(0.25, Point2D(640.f, 360.f), epicycles.data(), count, tip));
+
+    Renderer renderer;
+    for (auto _ : state) {
+        renderer.beginFrame();
+        renderer.drawArms(canvas, epicycles, tip);
+        renderer.drawEpicycles(canvas, epicycles);
+    }
+    state.counters["vertices"] = renderer.getStats().vertices;
+    state.counters["culled"] = renderer.getStats().circlesCulled;
+}
+BENCHMARK(BM_RenderEpicycles)->RangeMultiplier(4)->Range(16, 1024);
+
+static void BM_RenderTrail(benchmark::State& state) {
+    int length = static_cast<int>(state.range(0));
+    sf::RenderTexture canvas;
+    if (!canvas.resize({1280, 720})) {
+        state.SkipWithError("Offscreen render target unavailable");
+        return;
+    }
+
+    TrailBuffer trail(length);
+    for (const Point2D& point : makeDrawnPath(length)) trail.push(point);
+
+    Renderer renderer;
+    for (auto _ : state) {
+        renderer.beginFrame();
+        renderer.drawTrail(canvas, trail);
+    }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_RenderTrail)->RangeMultiplier(4)->Range(64, 16384);
+
+// One frame of a multi-drawing scene: every shape evaluated across the pool.
+// Arguments: shapes, threads (0: all cores)
+static void BM_SceneUpdate(benchmark::State& state) {
+    int shapes = static_cast<int>(state.range(0));
+    Scene scene(static_cast<int>(state.range(1)));
+    for (int i = 0; i < shapes; i++) {
+        scene.addShape(PathData::createStar(1024), Point2D(640.f, 360.f), 1.0 + 0.1 * (i % 5), TOP_K);
+    }
+    scene.update(0.0, 1.0);  // Transforms every path
+
+    for (auto _ : state) {
+        scene.update(1.0 / 60.0, 0.3);  // One frame at the default speed
+    }
+    state.SetItemsProcessed(state.iterations() * shapes);
+}
+BENCHMARK(BM_SceneUpdate)->ArgsProduct({{16, 64}, {1, 2, 4, 0}})
+    ->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,121 @@
+#include "FourierEngine.h"
+#include "PathData.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Throughput and accuracy of the float and double evaluation policies. Each
+// engine follows the realtime path (phasors advanced once per 240 Hz tick) for
+// a minute of animation; every tick's pen position and epicycle centers are
+// compared against a double engine evaluating cos/sin directly.
+
+namespace {
+
+const double TICK_RATE = 240.0;
+const double SPEED = 0.3;      // Periods per second, as in the app
+const int TICKS = 60 * 240;    // One minute of animation
+const int REPEATS = 5;
+const float PATH_SIZE = 600.f; // Pixels across, like a drawing filling the window
+
+struct Error {
+    double maxTip = 0.0;
+    double rmsTip = 0.0;
+    double maxCenter = 0.0;
+};
+
+template <typename Engine>
+void prepare(Engine& engine, const std::vector<Point2D>& path, int terms, EvaluationMode mode) {
+    engine.setNumEpicycles(terms);
+    engine.setEvaluationMode(mode);
+    engine.setTickRate(TICK_RATE);
+    engine.computeDFT(path);
+    engine.resetClock();
+}
+
+// Take the next tick on the engine's own clock, as the frame loop does
+template <typename Engine>
+double nextTick(Engine& engine) {
+    engine.accumulate(1.0 / TICK_RATE);
+    engine.step(SPEED);
+    return engine.getTime();
+}
+
+// Median nanoseconds per tick over the whole run
+template <typename Engine>
+double timeTicks(Engine& engine, int terms, std::vector<Epicycle>& out) {
+    std::vector<double> times;
+    Point2D tip;
+    for (int r = 0; r < REPEATS; r++) {
+        engine.resetClock();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < TICKS; i++) {
+            engine.getEpicycles(nextTick(engine), Point2D(), out.data(), terms, tip);
+        }
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / TICKS);
+    }
+    std::sort(times.begin(), times.end());
+    return times[REPEATS / 2];
+}
+
+template <typename Engine>
+Error measureError(Engine& engine, FourierEngine& reference, int terms,
+                   std::vector<Epicycle>& out, std::vector<Epicycle>& expected) {
+    Error error;
+    Point2D tip, expectedTip;
+    double sumSquares = 0.0;
+    for (int i = 0; i < TICKS; i++) {
+        double t = nextTick(engine);
+        int count = engine.getEpicycles(t, Point2D(), out.data(), terms, tip);
+        reference.getEpicycles(t, Point2D(), expected.data(), terms, expectedTip);
+
+        double tipError = std::hypot(tip.x - expectedTip.x, tip.y - expectedTip.y);
+        error.maxTip = std::max(error.maxTip, tipError);
+        sumSquares += tipError * tipError;
+        for (int j = 0; j < count; j++) {
+            error.maxCenter = std::max<double>(error.maxCenter,
+                std::hypot(out[j].center.x - expected[j].center.x, out[j].center.y - expected[j].center.y));
+        }
+    }
+    error.rmsTip = std::sqrt(sumSquares / TICKS);
+    return error;
+}
+
+template <typename Precision>
+void report(const std::vector<Point2D>& path, int terms, FourierEngine& reference,
+            std::vector<Epicycle>& out, std::vector<Epicycle>& expected) {
+    BasicFourierEngine<Precision> engine;
+    prepare(engine, path, terms, EvaluationMode::Phasor);
+    double ns = timeTicks(engine, terms, out);
+
+    BasicFourierEngine<Precision> fresh;
+    prepare(fresh, path, terms, EvaluationMode::Phasor);
+    Error error = measureError(fresh, reference, terms, out, expected);
+
+    std::printf("%8d %8s %12.1f %12.2f %12.2e %12.2e %12.2e\n", terms, Precision::NAME,
+                ns, 1000.0 / ns, error.maxTip, error.rmsTip, error.maxCenter);
+}
+
+} // namespace
+
+int main() {
+    std::vector<Point2D> path = PathData::fitPath(PathData::createStar(8192, 5, 120.f), PATH_SIZE);
+
+    std::printf("%d ticks at %.0f Hz; errors in pixels against direct double evaluation\n",
+                TICKS, TICK_RATE);
+    std::printf("%8s %8s %12s %12s %12s %12s %12s\n",
+                "terms", "policy", "ns/tick", "Mticks/s", "max tip", "rms tip", "max center");
+
+    for (int terms : {64, 200, 1024, 4096}) {
+        FourierEngine reference;
+        prepare(reference, path, terms, EvaluationMode::Direct);
+        std::vector<Epicycle> out(terms), expected(terms);
+
+        report<DoublePrecision>(path, terms, reference, out, expected);
+        report<SinglePrecision>(path, terms, reference, out, expected);
+    }
+
+    return 0;
+}
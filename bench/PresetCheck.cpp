@@ -0,0 +1,94 @@
+#include "FourierEngine.h"
+#include "PathData.h"
+#include "Presets.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+// Checks that the built-in shapes generated at compile time (Presets.cpp) still
+// match the runtime PathData::create* curves: same outline, and the same spectrum
+// as computeDFT of that outline. Exits with 1 if any shape has drifted.
+
+namespace {
+
+// The runtime generators compute in float, the presets in double
+const double TOLERANCE = 1e-3;  // Pixels
+
+// Outline the app showed for preset index (1-5) before presets were precomputed
+std::vector<Point2D> createShape(int index) {
+    switch (index) {
+        case 1:  return PathData::createCircle(100, 120.f);
+        case 2:  return PathData::createSquare(200, 250.f);
+        case 3:  return PathData::createStar(200, 5, 120.f);
+        case 4:  return PathData::createHeart(200, 10.f);
+        default: return PathData::createInfinity(200, 120.f);
+    }
+}
+
+struct Difference {
+    double outline = 0.0;    // Largest distance between matching points
+    double spectrum = 0.0;   // Largest distance between coefficients of the same frequency
+    double magnitude = 0.0;  // Largest difference in the i-th largest magnitude
+};
+
+Difference compare(const PresetShape& preset, const std::vector<Point2D>& path) {
+    Difference difference;
+    if (static_cast<int>(path.size()) != preset.pointCount) {
+        difference.outline = difference.spectrum = difference.magnitude = HUGE_VAL;
+        return difference;
+    }
+    for (int i = 0; i < preset.pointCount; i++) {
+        difference.outline = std::max<double>(difference.outline,
+            std::hypot(preset.points[i].x - path[i].x, preset.points[i].y - path[i].y));
+    }
+
+    FourierEngine engine;
+    engine.computeDFT(path);
+    engine.setNumEpicycles(0);  // Sort all of them
+    const CoefficientStore& coeffs = engine.getCoefficients();
+    if (static_cast<int>(coeffs.size()) != preset.coefficientCount) {
+        difference.spectrum = difference.magnitude = HUGE_VAL;
+        return difference;
+    }
+
+    // Equal magnitudes may sort either way, so terms are matched by frequency
+    std::map<int, int> byFrequency;
+    for (int i = 0; i < preset.coefficientCount; i++) byFrequency[preset.frequency[i]] = i;
+    for (std::size_t i = 0; i < coeffs.size(); i++) {
+        auto match = byFrequency.find(coeffs.frequency[i]);
+        if (match == byFrequency.end()) {
+            difference.spectrum = HUGE_VAL;
+            continue;
+        }
+        int j = match->second;
+        difference.spectrum = std::max(difference.spectrum,
+            std::hypot(preset.re[j] - coeffs.re[i], preset.im[j] - coeffs.im[i]));
+        difference.magnitude = std::max(difference.magnitude, std::abs(preset.radius[i] - coeffs.radius[i]));
+    }
+    return difference;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%10s %12s %12s %12s\n", "shape", "outline", "spectrum", "magnitudes");
+
+    bool matching = true;
+    for (int index = 1; index <= Presets::COUNT; index++) {
+        const PresetShape& preset = Presets::get(index);
+        Difference difference = compare(preset, createShape(index));
+        bool ok = difference.outline <= TOLERANCE && difference.spectrum <= TOLERANCE &&
+                  difference.magnitude <= TOLERANCE;
+        std::printf("%10s %12.2e %12.2e %12.2e%s\n", preset.name, difference.outline,
+                    difference.spectrum, difference.magnitude, ok ? "" : "  MISMATCH");
+        matching = matching && ok;
+    }
+
+    if (!matching) {
+        std::fprintf(stderr, "Presets differ from PathData::create* by more than %g px\n", TOLERANCE);
+        return 1;
+    }
+    return 0;
+}
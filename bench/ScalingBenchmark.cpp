@@ -0,0 +1,60 @@
+#include "FourierEngine.h"
+#include "PathData.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// Thread scaling of computeDFT on long paths: wall time for 1 to all hardware
+// threads, with speedup and parallel efficiency relative to one thread.
+
+namespace {
+
+const int TOP_K = 200;
+const int REPEATS = 5;
+
+// Median wall time of computeDFT in milliseconds
+double timeTransform(FourierEngine& engine, const std::vector<Point2D>& path) {
+    std::vector<double> times;
+    for (int r = 0; r < REPEATS; r++) {
+        auto start = std::chrono::steady_clock::now();
+        engine.computeDFT(path);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[REPEATS / 2];
+}
+
+} // namespace
+
+int main() {
+    int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int n : {1 << 16, 1 << 20, 1000000, 1 << 22}) {
+        std::vector<Point2D> path = PathData::createStar(n);
+        std::printf("N = %d\n%8s %12s %10s %12s\n", n, "threads", "ms", "speedup", "efficiency");
+
+        // Powers of two, always finishing on the full core count
+        std::vector<int> threadCounts;
+        for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+        threadCounts.push_back(maxThreads);
+
+        double serialMs = 0.0;
+        for (int threads : threadCounts) {
+            FourierEngine engine;
+            engine.setNumEpicycles(TOP_K);
+            engine.setTopK(TOP_K);
+            engine.setThreadCount(threads);
+
+            double ms = timeTransform(engine, path);
+            if (threads == 1) serialMs = ms;
+            double speedup = serialMs / ms;
+            std::printf("%8d %12.3f %9.2fx %11.0f%%\n", threads, ms, speedup, 100.0 * speedup / threads);
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "FourierEngine.h"
+#include "PathData.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Compares computeDFT with a full magnitude sort against top-K selection
+// (the K largest sorted, the rest left in place) for N = 1k to 1M.
+
+namespace {
+
+const int TOP_K = 200;  // The most epicycles the visualizer draws
+const int REPEATS = 5;
+
+// Median wall time of computeDFT in milliseconds
+double timeTransform(FourierEngine& engine, const std::vector<Point2D>& path) {
+    std::vector<double> times;
+    for (int r = 0; r < REPEATS; r++) {
+        auto start = std::chrono::steady_clock::now();
+        engine.computeDFT(path);
+        auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[REPEATS / 2];
+}
+
+} // namespace
+
+int main() {
+    std::printf("%10s %14s %14s %10s\n", "N", "full sort ms", "top-K ms", "speedup");
+
+    for (int n : {1000, 4000, 16000, 64000, 256000, 1000000}) {
+        std::vector<Point2D> path = PathData::createStar(n);
+
+        FourierEngine fullSort;
+        fullSort.setNumEpicycles(TOP_K);
+
+        FourierEngine topK;
+        topK.setNumEpicycles(TOP_K);
+        topK.setTopK(TOP_K);
+
+        double fullMs = timeTransform(fullSort, path);
+        double topKMs = timeTransform(topK, path);
+        std::printf("%10d %14.3f %14.3f %9.2fx\n", n, fullMs, topKMs, fullMs / topKMs);
+    }
+
+    return 0;
+}
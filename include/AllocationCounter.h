@@ -0,0 +1,23 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+// Global heap allocation counter for verifying the frame loop is allocation-free.
+// Counting is only compiled in with FOURIER_TRACK_ALLOCATIONS (CMake option of the
+// same name), which replaces the global operator new/delete; otherwise the
+// functions below are no-ops and count() stays at 0.
+namespace AllocationCounter {
+
+// True when operator new is being counted in this build
+bool enabled();
+
+// Total number of operator new calls so far
+std::size_t count();
+
+// Total bytes requested so far
+std::size_t bytes();
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,46 @@
+#ifndef COEFFICIENT_CACHE_H
+#define COEFFICIENT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "Types.h"
+#include "CoefficientStore.h"
+
+// On-disk cache of transformed paths, so a shape seen before skips its DFT.
+// One file per input path, named by a hash of its points:
+//   64-byte header  "FCCF", uint32 version, uint64 path hash, uint64 N,
+//                   uint64 coefficient count, uint64 sorted count,
+//                   uint64 payload checksum, 16 reserved bytes
+//   payload         re, im, radius, phase (float64 each), frequency (int32)
+// Files are written in native byte order (a cache is local to one machine) and
+// memory-mapped on load. Once the directory grows past its size limit the least
+// recently used files are deleted. Safe to use from several threads.
+class CoefficientCache {
+public:
+    CoefficientCache(const std::string& directory, std::uint64_t maxBytes);
+
+    // Key for a path: hash of its points and length
+    static std::uint64_t hashPath(const Point2D* points, std::size_t count);
+
+    // Fill out from the file for key, if there is a valid one for a path of
+    // pointCount points. Corrupt or mismatched files are deleted.
+    bool load(std::uint64_t key, std::size_t pointCount, CoefficientStore& out);
+
+    // Write the file for key, then trim the directory to the size limit
+    bool save(std::uint64_t key, std::size_t pointCount, const CoefficientStore& coeffs);
+
+    const std::string& getDirectory() const { return directory; }
+    std::uint64_t getMaxBytes() const { return maxBytes; }
+
+private:
+    std::string directory;
+    std::uint64_t maxBytes;
+    std::mutex writeMutex;  // Serializes saves and trimming
+
+    std::string fileFor(std::uint64_t key) const;
+    void trim();
+};
+
+#endif // COEFFICIENT_CACHE_H
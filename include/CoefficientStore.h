@@ -0,0 +1,53 @@
+#ifndef COEFFICIENT_STORE_H
+#define COEFFICIENT_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include "AlignedAllocator.h"
+
+// Fourier coefficients in structure-of-arrays form. Entry i is the term
+// re[i] + i*im[i] rotating at frequency[i]. Entries [0, sortedCount) are the
+// largest, sorted by magnitude; the rest are smaller and in no particular order.
+struct CoefficientStore {
+    AlignedVector<double> re;
+    AlignedVector<double> im;
+    AlignedVector<int> frequency;
+    AlignedVector<double> radius;   // |coefficient|
+    AlignedVector<double> phase;    // arg(coefficient)
+    AlignedVector<int> prefixMaxFrequency;  // Largest |k| among entries [0, i]
+    std::size_t sortedCount = 0;
+
+    std::size_t size() const { return re.size(); }
+    bool empty() const { return re.empty(); }
+
+    void clear() {
+        re.clear();
+        im.clear();
+        frequency.clear();
+        radius.clear();
+        phase.clear();
+        prefixMaxFrequency.clear();
+        sortedCount = 0;
+    }
+
+    void resize(std::size_t n) {
+        re.resize(n);
+        im.resize(n);
+        frequency.resize(n);
+        radius.resize(n);
+        phase.resize(n);
+        prefixMaxFrequency.resize(n);
+    }
+
+    // Recompute prefixMaxFrequency from entry begin onwards
+    void updatePrefixMaxFrequency(std::size_t begin = 0) {
+        int maxFrequency = begin > 0 ? prefixMaxFrequency[begin - 1] : 0;
+        for (std::size_t i = begin; i < size(); i++) {
+            maxFrequency = std::max(maxFrequency, std::abs(frequency[i]));
+            prefixMaxFrequency[i] = maxFrequency;
+        }
+    }
+};
+
+#endif // COEFFICIENT_STORE_H
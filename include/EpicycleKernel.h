@@ -0,0 +1,58 @@
+#ifndef EPICYCLE_KERNEL_H
+#define EPICYCLE_KERNEL_H
+
+// Vectorized inner loops for epicycle evaluation over structure-of-arrays data.
+// Each entry point dispatches at runtime to AVX2, SSE2 or a scalar fallback, and
+// comes in double and float versions (twice the lanes per register).
+namespace EpicycleKernel {
+
+enum class Isa {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Best instruction set supported by this CPU (detected once)
+Isa detectedIsa();
+
+// Instruction set currently used; can be lowered for testing/benchmarks
+Isa activeIsa();
+void setIsa(Isa isa);
+const char* isaName(Isa isa);
+
+// Chained prefix sum of rotated terms c[i] * p[i]:
+// center[i] = origin + sum_{j<i} c[j]*p[j]; tip receives the sum over all n
+void chain(const double* cRe, const double* cIm,
+           const double* pRe, const double* pIm, int n,
+           double originX, double originY,
+           double* centerX, double* centerY,
+           double& tipX, double& tipY);
+
+// Sum of rotated terms c[i] * p[i]
+void sum(const double* cRe, const double* cIm,
+         const double* pRe, const double* pIm, int n,
+         double& outX, double& outY);
+
+// p[i] *= s[i] (complex)
+void advance(double* pRe, double* pIm,
+             const double* sRe, const double* sIm, int n);
+
+// One Newton step pulling each |p[i]| toward 1
+void renormalize(double* pRe, double* pIm, int n);
+
+// Float versions of the above
+void chain(const float* cRe, const float* cIm,
+           const float* pRe, const float* pIm, int n,
+           float originX, float originY,
+           float* centerX, float* centerY,
+           float& tipX, float& tipY);
+void sum(const float* cRe, const float* cIm,
+         const float* pRe, const float* pIm, int n,
+         float& outX, float& outY);
+void advance(float* pRe, float* pIm,
+             const float* sRe, const float* sIm, int n);
+void renormalize(float* pRe, float* pIm, int n);
+
+} // namespace EpicycleKernel
+
+#endif // EPICYCLE_KERNEL_H
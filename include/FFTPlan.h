@@ -0,0 +1,57 @@
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+// Precomputed complex FFT of a fixed length.
+// Powers of two run an iterative radix-4 transform (plus one radix-2 stage when
+// log2(N) is odd), lengths built from small primes run a recursive mixed-radix
+// transform, and everything else goes through Bluestein's chirp-z algorithm.
+// A plan owns scratch memory, so it must not be used from two threads at once.
+class FFTPlan {
+public:
+    using Complex = std::complex<double>;
+
+    enum class Algorithm {
+        Radix4,
+        MixedRadix,
+        Bluestein
+    };
+
+    explicit FFTPlan(int n);
+
+    // In-place forward transform: X[k] = sum x[n] * e^(-i*2π*k*n/N)
+    void forward(Complex* data) const;
+
+    // In-place unnormalized inverse transform: x[n] = sum X[k] * e^(i*2π*k*n/N)
+    void inverse(Complex* data) const;
+
+    int size() const { return n; }
+    Algorithm algorithm() const { return algo; }
+
+    // Smallest length >= n whose only prime factors are 2, 3 and 5 (the
+    // cheapest lengths to transform after powers of two)
+    static int fastSize(int n);
+
+private:
+    int n;
+    Algorithm algo;
+
+    std::vector<Complex> twiddles;        // e^(-i*2π*j/N) for j in [0, N)
+    std::vector<int> bitReverse;          // Radix4: input permutation
+    std::vector<int> factors;             // MixedRadix: radices, outermost first
+    std::vector<Complex> chirp;           // Bluestein: e^(-iπ*n²/N)
+    std::vector<Complex> chirpSpectrum;   // Bluestein: FFT of the conjugate chirp
+    std::unique_ptr<FFTPlan> convolutionPlan;  // Bluestein: power-of-two inner FFT
+    mutable std::vector<Complex> scratch;
+
+    void transformRadix4(Complex* data) const;
+    void transformMixedRadix(Complex* data) const;
+    void mixedRadixStep(Complex* out, const Complex* in, int inStride,
+                        int length, int factorIndex) const;
+    void transformBluestein(Complex* data) const;
+};
+
+#endif // FFT_PLAN_H
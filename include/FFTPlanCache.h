@@ -0,0 +1,43 @@
+#ifndef FFT_PLAN_CACHE_H
+#define FFT_PLAN_CACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "FFTPlan.h"
+
+// Bounded cache of FFT plans keyed by transform length.
+// Plans (twiddles, permutations, scratch) are built on first use and reused
+// afterwards; when full, the least recently used plan is evicted.
+class FFTPlanCache {
+public:
+    explicit FFTPlanCache(std::size_t capacity = 8);
+
+    // Get the plan for length n, building it on a miss
+    std::shared_ptr<FFTPlan> acquire(int n);
+
+    // Drop every cached plan (counters are kept)
+    void clear();
+
+    // Change the bound, evicting old plans if needed
+    void setCapacity(std::size_t capacity);
+
+    // Statistics
+    std::size_t capacity() const { return maxEntries; }
+    std::size_t size() const { return entries.size(); }
+    std::size_t hits() const { return hitCount; }
+    std::size_t misses() const { return missCount; }
+    std::size_t evictions() const { return evictionCount; }
+
+private:
+    // Most recently used entry first
+    std::vector<std::shared_ptr<FFTPlan>> entries;
+    std::size_t maxEntries;
+    std::size_t hitCount;
+    std::size_t missCount;
+    std::size_t evictionCount;
+
+    void evictToCapacity();
+};
+
+#endif // FFT_PLAN_CACHE_H
@@ -3,33 +3,258 @@
 
 #include <vector>
 #include <complex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "Types.h"
+#include "Precision.h"
+#include "FFTPlanCache.h"
+#include "CoefficientStore.h"
+#include "ThreadPool.h"
+
+class CoefficientCache;
+struct PresetShape;
+
+// How rotating terms are evaluated each frame
+enum class EvaluationMode {
+    Direct,   // Evaluate cos/sin per term per call
+    Phasor    // Advance cached unit phasors by complex multiplication
+};
+
+// The chain evaluated at the two latest simulation ticks, so frames can be drawn
+// in between. Buffers are sized once for capacity epicycles.
+struct EpicycleTicks {
+    std::vector<Epicycle> epicycles[2];
+    Point2D tips[2];
+    int counts[2] = {0, 0};
+    int latest = 0;
+    bool stale = true;  // Set when the coefficients or count change; both slots are refilled
+
+    explicit EpicycleTicks(int capacity) {
+        epicycles[0].resize(capacity);
+        epicycles[1].resize(capacity);
+    }
+
+    const Point2D& latestTip() const { return tips[latest]; }
+};
+
+// Transforms run in double for any policy. Per-frame evaluation (phasors, rotated
+// terms, chained centers) runs in Precision::Real; see Precision.h. Instantiated
+// for SinglePrecision and DoublePrecision in FourierEngine.cpp.
+template <typename Precision>
+class BasicFourierEngine {
+public:
+    using Real = typename Precision::Real;
 
-class FourierEngine {
 private:
-    std::vector<std::complex<double>> coefficients;
-    std::vector<int> frequencies;  // Corresponding frequency for each coefficient
+    CoefficientStore coeffs;  // Sorted by magnitude, largest first
     std::vector<Point2D> originalPath;
     int numEpicycles;
-    double time;
+    int topK;  // Coefficients sorted up front (0 sorts all)
+
+    // Fixed-step simulation clock
+    double tickRate;       // Ticks per second
+    double accumulator;    // Frame time not yet spent on ticks, in ticks
+    double clockTime;      // Curve time (periods) at the latest tick
+    std::uint64_t tickCount;
+
+    // FFT plans by length, plus reusable transform buffers
+    mutable FFTPlanCache planCache;
+    std::vector<std::complex<double>> spectrum;
+    mutable std::vector<std::complex<double>> sampleBuffer;
+
+    // Evaluation cache: phasor[i] = e^(i*2π*k_i*phasorTime), stored as SoA.
+    // Mutated by the const evaluation methods, so one engine per thread.
+    EvaluationMode evaluationMode;
+    AlignedVector<Real> termRe, termIm;                     // coeffs in Real; empty when Real is double
+    mutable AlignedVector<Real> phasorRe, phasorIm;
+    mutable AlignedVector<Real> stepRe, stepIm;             // e^(i*2π*k_i*stepSize) for i < stepCount
+    mutable std::vector<std::complex<double>> stepPowers;   // e^(i*2π*k*stepSize) for k >= 0
+    mutable AlignedVector<Real> centerX, centerY;           // Chained centers
+    mutable double phasorTime;
+    mutable double stepSize;
+    mutable int stepCount;
+    mutable int phasorCount;  // Phasors [0, phasorCount) are current at phasorTime
+    mutable int phasorSteps;  // Advances since the last direct evaluation
+    mutable bool phasorsValid;
+
+    // Background transforms. The worker fills spare stores and publishes them
+    // through a lock-free triple buffer: the render thread owns frontSlot, the
+    // worker owns backSlot, and middleSlot holds the latest finished result.
+    // Long paths publish coarse previews from a decimated path before the exact set.
+    CoefficientStore slots[3];
+    std::vector<Point2D> slotPaths[3];  // Source path, only filled for exact results
+    std::uint64_t slotGeneration[3];
+    bool slotExact[3];
+    int frontSlot;
+    int backSlot;
+    std::atomic<int> middleSlot;  // Slot index, plus PUBLISHED_FLAG when unread
+    std::atomic<std::uint64_t> latestGeneration;  // Newest request, sync or async
+    std::uint64_t coeffsGeneration;  // Request that produced coeffs
+    bool coeffsExact;                // False while coeffs is a coarse preview
+    bool refined;                    // Last acquire refined the same request
+
+    std::thread worker;
+    std::mutex requestMutex;
+    std::condition_variable requestReady;
+    std::vector<Point2D> pendingPath;
+    std::uint64_t pendingGeneration;
+    int pendingSortCount;
+    bool hasPending;
+    bool stopWorker;
+    std::atomic<bool> computing;
+    FFTPlanCache workerPlans;  // Plans own scratch memory, so the worker has its own
+
+    // Shared by computeDFT and the worker for long paths; built on first use
+    // (guarded by requestMutex) and rebuilt when the thread count changes
+    std::shared_ptr<ThreadPool> pool;
+    int threadCount;  // 0: hardware concurrency
+    std::vector<std::complex<double>> workerSpectrum;
+    std::vector<Point2D> previewPath;
+
+    // Transforms already on disk are loaded instead of recomputed (guarded by requestMutex)
+    std::shared_ptr<CoefficientCache> cache;
+
+    void workerLoop();
+    void publish(std::uint64_t generation, bool exact);
+
+    // Pool for a transform of n points, or null if it should run serially.
+    // Caller holds requestMutex.
+    std::shared_ptr<ThreadPool> acquirePool(int n);
+
+    // Size evaluation buffers for the current coeffs and drop cached phasors
+    void adoptCoefficients();
+
+    // Refresh termRe/termIm from coeffs entries [begin, size)
+    void convertTerms(int begin);
+    const Real* termsRe() const;
+    const Real* termsIm() const;
+
+    // Coefficients taking part in evaluation: the numEpicycles largest
+    int activeCount() const;
+
+    // Coefficients to sort in a new transform: the active ones, at least topK
+    int sortCount() const;
+
+    // Extend the sorted prefix of coeffs to at least count entries
+    void ensureSorted(int count);
+
+    // Bring the active phasors to time t (advance, or re-evaluate directly on a jump)
+    void syncPhasors(double t) const;
+    void evaluatePhasors(double t, int begin, int end) const;
 
 public:
-    FourierEngine();
+    BasicFourierEngine();
+    ~BasicFourierEngine();
+
+    BasicFourierEngine(const BasicFourierEngine&) = delete;
+    BasicFourierEngine& operator=(const BasicFourierEngine&) = delete;
 
-    // Compute DFT from path points
+    // Compute DFT from path points (blocking; supersedes any background transform)
     void computeDFT(const std::vector<Point2D>& path);
 
-    // Get epicycle positions at current time
-    std::vector<Epicycle> getEpicycles(double t) const;
+    // Same, keeping path as the source outline without copying it
+    void computeDFT(std::vector<Point2D>&& path);
+
+    // Adopt a built-in shape's precomputed spectrum, scaled by scale (blocking like
+    // computeDFT, but no transform: the coefficients are copied from the table)
+    void loadPreset(const PresetShape& preset, float scale = 1.f);
+
+    // Queue a transform on the background worker. The current coefficients keep
+    // animating until acquireLatest() swaps the result in; a newer submission
+    // cancels or supersedes the one in flight.
+    void submitPath(const std::vector<Point2D>& path);
+
+    // Same, handing path to the worker without copying it
+    void submitPath(std::vector<Point2D>&& path);
+
+    // Swap in the newest finished background result. Call once per frame from the
+    // render thread; returns true if the coefficient set changed.
+    bool acquireLatest();
+
+    // True while a submitted path is queued or being transformed
+    bool isComputing() const;
+
+    // False while the coefficients are a coarse preview of a long path
+    bool isExact() const;
+
+    // True if the last acquireLatest() refined the shape already showing rather
+    // than switching to a new one (the time parameter carries over)
+    bool isRefinement() const;
+
+    // Every evaluation below only touches the active (largest numEpicycles) terms
+
+    // Get epicycles at time t, chained end to end starting at origin
+    std::vector<Epicycle> getEpicycles(double t, Point2D origin = Point2D()) const;
+
+    // Allocation-free variant for the frame loop: fills out[0..capacity) (colors are
+    // left untouched), stores the pen position in tip and returns the count written
+    int getEpicycles(double t, Point2D origin, Epicycle* out, int capacity, Point2D& tip) const;
 
     // Get the traced point at current time
     Point2D getTracedPoint(double t) const;
 
-    // Update time and animation state
-    void update(double dt, double speed);
+    // Fill out[0..numSamples) with the traced curve at t = startTime + m/numSamples,
+    // using the first numTerms coefficients (active count if negative). One inverse FFT.
+    // Terms past the sorted prefix are not necessarily the largest.
+    void sampleCurve(Point2D* out, int numSamples, int numTerms = -1, double startTime = 0.0) const;
 
-    // Setters
+    // Simulation clock. Frame time goes into an accumulator and comes out as
+    // fixed ticks of 1 / tickRate seconds, each moving the curve time on by
+    // speed / tickRate periods. Evaluating once per tick keeps the phasor
+    // updates, and so every sampled point, the same at any frame rate.
+    void setTickRate(double ticksPerSecond);
+    double getTickRate() const;
+    void accumulate(double seconds);
+    bool step(double speed);  // Take one due tick; false once none is left
+    double getTime() const;   // Curve time at the latest tick
+    double getInterpolation() const;  // Part of a tick accumulated past the latest, in [0, 1)
+    std::uint64_t getTickCount() const;
+    void resetClock();
+
+    // Evaluate the chain at the latest tick into ticks (both slots if stale)
+    void evaluateTick(Point2D origin, EpicycleTicks& ticks) const;
+
+    // Blend the two latest ticks by getInterpolation() into out[0..count);
+    // returns the pen position. out must hold the ticks' capacity.
+    Point2D interpolateTicks(const EpicycleTicks& ticks, Epicycle* out, int& count) const;
+
+    // Setters (n <= 0 means all coefficients). Raising the count past the sorted
+    // prefix sorts just enough of the remaining coefficients.
     void setNumEpicycles(int n);
+    void setEvaluationMode(EvaluationMode mode);
+
+    // Top-K mode: later transforms select and sort only the k largest coefficients
+    // (or the active count, if larger) instead of sorting all N. 0 sorts all.
+    void setTopK(int k);
+
+    // Threads used for long transforms (0: hardware concurrency, 1: serial).
+    // Paths shorter than ParallelFFT::MIN_PARALLEL_SIZE always run serially.
+    void setThreadCount(int threads);
+
+    // Look up transforms in cache before computing them and store new ones
+    // there (null disables). Shared, so several engines can use one directory.
+    void setCache(std::shared_ptr<CoefficientCache> cache);
+
+    // Number of coefficients currently evaluated
+    int getActiveEpicycles() const;
+
+    // Coefficients (structure-of-arrays), sorted up to sortedCount
+    const CoefficientStore& getCoefficients() const;
+
+    // Plan cache (capacity and hit/miss counters)
+    FFTPlanCache& getPlanCache();
+    const FFTPlanCache& getPlanCache() const;
 };
 
+extern template class BasicFourierEngine<SinglePrecision>;
+extern template class BasicFourierEngine<DoublePrecision>;
+
+// Realtime drawing evaluates in float; offline rendering, export and tools in double
+using RealtimeFourierEngine = BasicFourierEngine<SinglePrecision>;
+using FourierEngine = BasicFourierEngine<DoublePrecision>;
+
 #endif // FOURIER_ENGINE_H
@@ -0,0 +1,53 @@
+#ifndef FRAME_WRITER_H
+#define FRAME_WRITER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+// Writes rendered frames as numbered PNGs (frame_00000.png, ...) on a background
+// thread so encoding overlaps rendering of the next frame.
+class FrameWriter {
+public:
+    // maxQueuedFrames bounds memory: submit() blocks while that many are pending
+    explicit FrameWriter(const std::string& directory, std::size_t maxQueuedFrames = 8);
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    // Queue the next frame for writing
+    void submit(sf::Image image);
+
+    // Block until every queued frame has been written, then stop the worker
+    void finish();
+
+    // Query state
+    int getFramesWritten() const;
+    int getFailures() const;
+    const std::string& getDirectory() const;
+
+private:
+    std::string directory;
+    std::size_t maxQueued;
+    int nextIndex;
+
+    std::deque<std::pair<int, sf::Image>> queue;
+    std::mutex queueMutex;
+    std::condition_variable queueChanged;
+    bool stopping;
+
+    std::atomic<int> framesWritten;
+    std::atomic<int> failures;
+    std::thread worker;
+
+    void run();
+};
+
+#endif // FRAME_WRITER_H
@@ -4,6 +4,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include "Types.h"
+#include "PathData.h"
 
 class InputHandler {
 public:
@@ -14,6 +15,8 @@ public:
 
     // Query state
     bool isDrawing() const;
+    // Stroke resampled every pixel of arc length as the mouse moves (the spacing
+    // doubles whenever a long stroke outgrows the resampler)
     const std::vector<Point2D>& getDrawnPath() const;
 
     // Clear the drawn path
@@ -21,7 +24,7 @@ public:
 
 private:
     bool drawing;
-    std::vector<Point2D> drawnPath;
+    StreamingResampler drawnPath;
 };
 
 #endif // INPUT_HANDLER_H
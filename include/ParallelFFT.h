@@ -0,0 +1,21 @@
+#ifndef PARALLEL_FFT_H
+#define PARALLEL_FFT_H
+
+#include <complex>
+#include "ThreadPool.h"
+
+// Four-step FFT for long transforms. N = N1 * N2 is computed as N2 column FFTs
+// of length N1, a twiddle multiply, and N1 row FFTs of length N2; the columns
+// and rows are independent and spread across the pool. Matches FFTPlan::forward.
+namespace ParallelFFT {
+
+// Smallest length worth splitting; shorter transforms stay on one thread
+const int MIN_PARALLEL_SIZE = 1 << 15;
+
+// In-place forward transform. Returns false, leaving data untouched, when n is
+// below MIN_PARALLEL_SIZE, the pool has one thread, or n has no balanced split.
+bool forward(std::complex<double>* data, int n, ThreadPool& pool);
+
+} // namespace ParallelFFT
+
+#endif // PARALLEL_FFT_H
@@ -1,6 +1,7 @@
 #ifndef PATH_DATA_H
 #define PATH_DATA_H
 
+#include <cstddef>
 #include <vector>
 #include "Types.h"
 
@@ -21,11 +22,67 @@ public:
     // Generate an infinity symbol path
     static std::vector<Point2D> createInfinity(int numPoints, float scale = 100.f);
 
-    // Utility: resample path to have a specific number of points
+    // Utility: resample path to targetPoints points evenly spaced by arc length,
+    // keeping both end points. O(N + targetPoints).
     static std::vector<Point2D> resamplePath(const std::vector<Point2D>& path, int targetPoints);
 
+    // Same, reading points in place (e.g. straight from a memory-mapped file)
+    static std::vector<Point2D> resamplePath(const Point2D* points, std::size_t count, int targetPoints);
+
+    // Utility: drop points while staying within tolerance of the original
+    // polyline (Ramer-Douglas-Peucker). End points are always kept.
+    static std::vector<Point2D> simplifyPath(const std::vector<Point2D>& path, float tolerance);
+
+    // Utility: smallest FFT-friendly point count in [minPoints, maxPoints] for which
+    // resampling path by arc length stays within tolerance of it (chords cutting
+    // corners are the only error). maxPoints if none does.
+    static int chooseSampleCount(const std::vector<Point2D>& path, float tolerance,
+                                 int minPoints = 64, int maxPoints = 4096);
+
     // Utility: center a path around a specific point
     static std::vector<Point2D> centerPath(const std::vector<Point2D>& path, Point2D center);
+
+    // Utility: scale a path about the origin so the larger side of its bounding box is size
+    static std::vector<Point2D> fitPath(const std::vector<Point2D>& path, float size);
+
+    // Utility: both of the above in place, centroid to the origin and the larger
+    // side of the bounding box to size. Reads the path once and writes it once.
+    static void centerAndFitPath(std::vector<Point2D>& path, float size);
+};
+
+// Resamples a stroke while it is being drawn: points arrive one at a time and
+// samples are emitted every spacing units of arc length. When the samples
+// outnumber capacity, every other one is dropped and the spacing doubles, so a
+// long stroke stays bounded and still evenly spaced.
+class StreamingResampler {
+public:
+    explicit StreamingResampler(double spacing = 1.0, std::size_t capacity = 4096);
+
+    void reset();
+
+    // Add the next raw point of the stroke
+    void addPoint(Point2D point);
+
+    // End the stroke at the last raw point (points added later continue it)
+    void finish();
+
+    // Evenly spaced samples so far, plus the end point after finish()
+    const std::vector<Point2D>& getPoints() const { return points; }
+    double getLength() const { return length; }
+    double getSpacing() const { return spacing; }
+
+private:
+    std::vector<Point2D> points;
+    Point2D last;        // Last raw point
+    double initialSpacing;
+    double spacing;
+    double untilNext;    // Arc length from last to the next sample
+    double length;       // Arc length of the raw stroke
+    std::size_t capacity;
+    bool finished;       // points ends with the raw end point
+
+    // Halve the samples; returns the change to apply to the next sample position
+    double thin();
 };
 
 #endif // PATH_DATA_H
@@ -0,0 +1,56 @@
+#ifndef PATH_LOADER_H
+#define PATH_LOADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "MappedFile.h"
+
+// Points read from a file. Binary point files are used in place from the
+// memory mapping; text formats are parsed (from the mapping) into owned storage.
+class LoadedPath {
+public:
+    LoadedPath();
+
+    const Point2D* data() const { return points; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    friend class PathLoader;
+
+    MappedFile mapping;
+    std::vector<Point2D> owned;
+    const Point2D* points;
+    std::size_t count;
+};
+
+// Loads outlines exported from other tools:
+//   SVG     every <path d="..."> (all commands; curves and arcs flattened)
+//   CSV     one "x,y" per line (commas, spaces, tabs or semicolons; '#' comments)
+//   Binary  16-byte header ("FPTS", uint32 version 1, uint64 count), then count
+//           little-endian float32 x/y pairs
+// Loaders return false and print the reason to stderr on failure.
+class PathLoader {
+public:
+    enum class Format {
+        Auto,    // From the extension, else by sniffing the contents
+        SVG,
+        CSV,
+        Binary
+    };
+
+    static bool load(const std::string& filename, LoadedPath& out, Format format = Format::Auto);
+
+    // Parse in-memory text; tolerance is the largest distance (in SVG user units)
+    // a flattened curve may stray from the true curve
+    static bool parseSVG(const char* text, std::size_t length, std::vector<Point2D>& out,
+                         float tolerance = 0.25f);
+    static bool parseCSV(const char* text, std::size_t length, std::vector<Point2D>& out);
+
+    // Write points in the binary format
+    static bool writeBinary(const std::string& filename, const Point2D* points, std::size_t count);
+};
+
+#endif // PATH_LOADER_H
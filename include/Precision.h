@@ -0,0 +1,26 @@
+#ifndef PRECISION_H
+#define PRECISION_H
+
+// Scalar precision policies for per-frame evaluation (BasicFourierEngine, BasicScene).
+// Transforms always run in double; the policy picks the type of the phasors,
+// rotated terms and chained centers, and how often phasor drift is corrected.
+// Float halves the memory traffic and doubles the SIMD width, but each operation
+// rounds about 2^29 times more coarsely, so phasors are corrected more often.
+
+// Realtime drawing: all-float SIMD
+struct SinglePrecision {
+    using Real = float;
+    static constexpr int RENORMALIZE_INTERVAL = 16; // Advances between |phasor| -> 1 corrections
+    static constexpr int RESYNC_INTERVAL = 1024;    // Advances between direct cos/sin evaluations
+    static constexpr const char* NAME = "float";
+};
+
+// Offline rendering and export: full double precision throughout
+struct DoublePrecision {
+    using Real = double;
+    static constexpr int RENORMALIZE_INTERVAL = 64;
+    static constexpr int RESYNC_INTERVAL = 4096;
+    static constexpr const char* NAME = "double";
+};
+
+#endif // PRECISION_H
@@ -0,0 +1,32 @@
+#ifndef PRESETS_H
+#define PRESETS_H
+
+#include "Types.h"
+
+// A built-in shape with its spectrum, both generated at compile time. The
+// coefficient arrays use the CoefficientStore layout, fully sorted by magnitude,
+// so selecting a preset copies them into the engine without any transform.
+struct PresetShape {
+    const char* name;
+    const Point2D* points;          // Outline, centered on the origin
+    int pointCount;
+    const double* re;
+    const double* im;
+    const int* frequency;
+    const double* radius;
+    const double* phase;
+    const int* prefixMaxFrequency;
+    int coefficientCount;
+    float extent;                   // Larger side of the bounding box, for fitting
+};
+
+namespace Presets {
+
+const int COUNT = 5;
+
+// Shape 1-5: circle, square, star, heart, infinity; anything else is the circle
+const PresetShape& get(int index);
+
+} // namespace Presets
+
+#endif // PRESETS_H
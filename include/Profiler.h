@@ -0,0 +1,108 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Stages of one frame of the main loop
+enum class ProfileZone {
+    Frame,      // Whole loop iteration
+    Events,     // Window events and input
+    Transform,  // Picking up or running DFTs
+    Evaluate,   // Epicycles at each simulation tick and between ticks, and colors
+    Trail,      // Pen sampling into the trails
+    Render,     // Scene geometry and draw calls
+    UI,         // Labels and panels
+    Present,    // display() or frame export
+    Count
+};
+
+// Per-zone frame timings for the render thread. Keeps the last HISTORY samples
+// of each zone for min/avg/p99, and optionally every sample as a Chrome
+// trace-event file (load it in Perfetto or chrome://tracing).
+// While disabled, a ProfileScope costs one branch and reads no clock.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int HISTORY = 240;
+
+    struct ZoneStats {
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p99Ms = 0.0;
+        int samples = 0;
+    };
+
+    Profiler();
+
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled; }
+
+    // Keep every sample from now on for writeTrace (also enables recording)
+    void startTrace();
+    bool isTracing() const { return tracing; }
+
+    // Write the recorded samples as Chrome trace-event JSON; false on I/O failure
+    bool writeTrace(const std::string& path) const;
+
+    void record(ProfileZone zone, Clock::time_point start, Clock::time_point end);
+
+    // Statistics over the recent history of a zone
+    ZoneStats getStats(ProfileZone zone) const;
+
+    static const char* zoneName(ProfileZone zone);
+
+private:
+    static constexpr int ZONE_COUNT = static_cast<int>(ProfileZone::Count);
+
+    struct TraceEvent {
+        ProfileZone zone;
+        double startUs;
+        double durationUs;
+    };
+
+    bool enabled;
+    bool tracing;
+    Clock::time_point origin;
+
+    // Ring of recent durations (ms) per zone
+    std::array<std::array<float, HISTORY>, ZONE_COUNT> history;
+    std::array<int, ZONE_COUNT> historySize;
+    std::array<int, ZONE_COUNT> historyNext;
+    mutable std::array<float, HISTORY> sortScratch;
+
+    std::vector<TraceEvent> trace;
+};
+
+// Times the enclosing scope (or up to stop()) into one zone
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, ProfileZone zone)
+        : profiler(profiler), zone(zone), active(profiler.isEnabled()) {
+        if (active) start = Profiler::Clock::now();
+    }
+
+    ~ProfileScope() { stop(); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    // End the zone early, for stages that don't sit in their own block
+    void stop() {
+        if (!active) return;
+        profiler.record(zone, start, Profiler::Clock::now());
+        active = false;
+    }
+
+private:
+    Profiler& profiler;
+    ProfileZone zone;
+    bool active;
+    Profiler::Clock::time_point start;
+};
+
+#endif // PROFILER_H
@@ -2,22 +2,134 @@
 #define RENDERER_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include "Types.h"
+#include "TrailBuffer.h"
 
+// Per-frame counters, reset by beginFrame()
+struct RenderStats {
+    int circlesDrawn = 0;     // Tessellated epicycle circles
+    int circlesCulled = 0;    // Circles below the cull radius, collapsed to a point
+    int vertices = 0;         // Vertices submitted
+    int drawCalls = 0;
+};
+
+// One drawing's visible epicycles and pen position, for drawing many at once
+struct EpicycleSet {
+    const Epicycle* epicycles;
+    int count;
+    Point2D tip;
+};
+
+// Each draw method rebuilds one persistent vertex array and submits it with a
+// single draw call, so the cost per layer doesn't grow with the primitive count.
+// Epicycle circles pick their segment count from their on-screen radius.
+// The trail is the exception: its geometry stays on the GPU and only chunks
+// that changed are re-uploaded, with the fade computed in a vertex shader.
 class Renderer {
 public:
     Renderer();
 
+    // Reset per-frame statistics (and free meshes of trails no longer drawn)
+    void beginFrame();
+    const RenderStats& getStats() const;
+
+    // Circles with an on-screen radius below this many pixels are drawn as a point
+    void setCullRadius(float pixels);
+
+    // Largest distance (pixels) a tessellated circle may deviate from the true circle
+    void setTessellationTolerance(float pixels);
+
     // Draw methods
-    void drawTrail(sf::RenderWindow& window, const std::vector<Point2D>& trail);
-    void drawEpicycles(sf::RenderWindow& window, const std::vector<Epicycle>& epicycles);
-    void drawGlow(sf::RenderWindow& window, const Point2D& position);
-    void drawUserPath(sf::RenderWindow& window, const std::vector<Point2D>& path);
+    // Fading trail, or in closed mode the recorded curve (joined once complete)
+    void drawTrail(sf::RenderTarget& target, const TrailBuffer& trail);
+    void drawEpicycles(sf::RenderTarget& target, const std::vector<Epicycle>& epicycles);
+    void drawArms(sf::RenderTarget& target, const std::vector<Epicycle>& epicycles, const Point2D& tip);
+    void drawGlow(sf::RenderTarget& target, const Point2D& position);
+
+    // Many drawings at once: the arms, circles and pen glows of every set go
+    // into one batch per layer (arms and circles only if showEpicycles)
+    void drawEpicycleSets(sf::RenderTarget& target, const std::vector<EpicycleSet>& sets, bool showEpicycles);
+    void drawUserPath(sf::RenderTarget& target, const std::vector<Point2D>& path);
+    void drawOutline(sf::RenderTarget& target, const std::vector<Point2D>& outline, Point2D offset);
+
+    // Color epicycles[0..count) with the Pink -> Cyan -> Purple gradient, spread
+    // over the first five (the rest are Purple)
+    static void colorEpicycles(Epicycle* epicycles, int count);
 
 private:
+    // Unit circle templates shared by every circle and dot; circleLevels[i]
+    // has MIN_CIRCLE_SEGMENTS << i points
+    std::vector<std::vector<sf::Vector2f>> circleLevels;
+    std::vector<sf::Vector2f> unitCircle;
+    std::vector<sf::Vector2f> unitDot;
+
+    float cullRadius;
+    float tessellationTolerance;
+    RenderStats stats;
+
+    // Trail segments as a line list: chunk c of the trail owns vertices
+    // [c * 2 * CHUNK_SIZE, (c + 1) * 2 * CHUNK_SIZE), rebuilt and uploaded when
+    // its version changes. texCoords.x holds the point's sequence number.
+    struct TrailMesh {
+        std::uint64_t lastFrame = 0;  // Frame it was last drawn in
+        std::vector<sf::Vertex> vertices;
+        std::vector<std::uint64_t> versions;  // Version each chunk was built from
+        sf::VertexBuffer buffer{sf::PrimitiveType::Lines, sf::VertexBuffer::Usage::Dynamic};
+        bool useBuffer = false;
+    };
+    std::unordered_map<std::uint64_t, TrailMesh> trailMeshes;  // By trail id
+    std::uint64_t frameNumber;
+    sf::Shader trailShader;
+    bool trailShaderLoaded;
+    bool trailShaderTried;
+
+    // Batched geometry, one array per layer; capacity is kept between frames
+    sf::VertexArray trailVertices;     // Lines (closing segment of a closed trail)
+    sf::VertexArray circleVertices;    // Lines
+    sf::VertexArray dotVertices;       // Triangles
+    sf::VertexArray pointVertices;     // Points (culled circles)
+    sf::VertexArray armVertices;       // LineStrip
+    sf::VertexArray armLineVertices;   // Lines (arms of several drawings)
+    sf::VertexArray glowVertices;      // Triangles, additive
+    sf::VertexArray pathVertices;      // LineStrip
+    sf::VertexArray outlineVertices;   // LineStrip
+
+    // Append a circle outline as line segments using the given template
+    void appendCircle(sf::VertexArray& vertices, const std::vector<sf::Vector2f>& unit,
+                      sf::Vector2f center, float radius, sf::Color color);
+
+    // Template with enough segments for a circle of this many pixels
+    const std::vector<sf::Vector2f>& circleForRadius(float pixelRadius) const;
+
+    // Submit a batch and count it
+    void submit(sf::RenderTarget& target, const sf::VertexArray& vertices,
+                const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Mesh for trail, with the chunks that changed since its last draw rebuilt
+    TrailMesh& updateTrailMesh(const TrailBuffer& trail);
+
+    // Draw trail chunks [first, first + count) in storage order
+    void submitTrailChunks(sf::RenderTarget& target, const TrailBuffer& trail, const TrailMesh& mesh,
+                           int first, int count, const sf::RenderStates& states);
+
+    // World units to pixels, from the current view and viewport
+    float pixelScale(const sf::RenderTarget& target) const;
+
+    // Append circles (or points, when culled) and center dots for epicycles
+    void appendEpicycles(const Epicycle* epicycles, int count, float scale);
+
+    // Append the layered pen glow at position
+    void appendGlow(sf::Vector2f position);
+
+    // Append a filled disc as a triangle fan flattened to triangles
+    void appendDisc(sf::VertexArray& vertices, const std::vector<sf::Vector2f>& unit,
+                    sf::Vector2f center, float radius, sf::Color color);
+
     // Helper function for color interpolation
-    sf::Color lerpColor(sf::Color a, sf::Color b, float t);
+    static sf::Color lerpColor(sf::Color a, sf::Color b, float t);
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,82 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+#include "Types.h"
+#include "FourierEngine.h"
+#include "Presets.h"
+#include "Renderer.h"
+#include "ThreadPool.h"
+#include "TrailBuffer.h"
+
+// One drawing in a scene: its own coefficients, speed, position and trail
+template <typename Precision>
+struct BasicSceneShape {
+    BasicFourierEngine<Precision> engine;
+    std::vector<Point2D> path;         // Transformed on the next update when pending
+    const PresetShape* preset = nullptr;  // Loaded instead of path when set
+    float presetScale = 1.f;
+    bool pending = false;
+    Point2D origin;                    // Screen position of the first epicycle
+    double speed = 1.0;                // Multiplies the scene speed
+    int maxEpicycles;
+    EpicycleTicks ticks;               // Chain at the engine clock's two latest ticks
+    std::vector<Epicycle> epicycles;   // Between ticks for drawing; sized for maxEpicycles
+    int visibleEpicycles = 0;
+    Point2D tip;
+    TrailBuffer trail;
+
+    BasicSceneShape(int epicycleCapacity, int trailCapacity)
+        : maxEpicycles(epicycleCapacity), ticks(epicycleCapacity),
+          epicycles(epicycleCapacity), trail(trailCapacity) {}
+};
+
+// Many independent drawings animated together (display walls). update()
+// transforms new paths and evaluates every shape across a thread pool, each
+// shape on one thread, so frame time grows with shapes / cores. draw() sends
+// the epicycles of all shapes to the renderer as one batch per layer. Shapes
+// evaluate in the precision policy's scalar type (see Precision.h).
+template <typename Precision>
+class BasicScene {
+public:
+    using Shape = BasicSceneShape<Precision>;
+
+    // threads counts the calling thread; 0 uses every core
+    explicit BasicScene(int threads = 0);
+
+    // Add a drawing of path (centered on the origin) at origin. Returns its index.
+    int addShape(const std::vector<Point2D>& path, Point2D origin, double speed, int epicycles);
+
+    // Add a built-in shape, scaled to size across; its spectrum is precomputed
+    int addShape(const PresetShape& preset, Point2D origin, double speed, int epicycles, float size);
+
+    // Replace a drawing's path; it restarts once transformed
+    void setPath(int index, const std::vector<Point2D>& path);
+
+    // Advance every shape's clock by dt seconds at speed periods per second
+    // (times its own speed), sampling trails at every tick
+    void update(double dt, double speed);
+
+    // Restart every drawing from t = 0 with an empty trail
+    void reset();
+
+    void draw(sf::RenderTarget& target, Renderer& renderer, bool showEpicycles, bool showTrails);
+
+    int size() const { return static_cast<int>(shapes.size()); }
+    const Shape& getShape(int index) const { return *shapes[index]; }
+
+private:
+    std::vector<std::unique_ptr<Shape>> shapes;
+    ThreadPool pool;
+    std::vector<EpicycleSet> sets;  // Reused by draw()
+};
+
+extern template class BasicScene<SinglePrecision>;
+extern template class BasicScene<DoublePrecision>;
+
+// Display walls are a realtime path
+using Scene = BasicScene<SinglePrecision>;
+
+#endif // SCENE_H
@@ -0,0 +1,93 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. Each worker owns a ring
+// of range chunks: it takes from the back of its own and steals from the front
+// of the others when it runs dry. The calling thread helps until its loop is done,
+// so parallelFor may be called from several threads at once. Rings are allocated
+// once at construction, so a loop allocates nothing.
+class ThreadPool {
+public:
+    // Non-owning reference to a loop body called as body(begin, end). Unlike
+    // std::function it never copies the callable, so captures cost no allocation.
+    class Body {
+    public:
+        template <typename F, typename = typename std::enable_if<
+                                  !std::is_same<typename std::remove_cv<F>::type, Body>::value>::type>
+        Body(F& body) : object(const_cast<void*>(static_cast<const void*>(&body))), call(&invoke<F>) {}
+
+        void operator()(int begin, int end) const { call(object, begin, end); }
+
+    private:
+        void* object;
+        void (*call)(void*, int, int);
+
+        template <typename F>
+        static void invoke(void* object, int begin, int end) {
+            (*static_cast<F*>(object))(begin, end);
+        }
+    };
+
+    // threads counts the caller too; 0 uses std::thread::hardware_concurrency
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Run body over [0, count) in chunks of about grain indices; blocks until done.
+    // body only has to outlive the call.
+    template <typename F>
+    void parallelFor(int count, int grain, F&& body) {
+        typename std::remove_reference<F>::type& callable = body;
+        run(count, grain, Body(callable));
+    }
+
+    // Threads that run work, including the caller
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+private:
+    struct Task {
+        const Body* body;
+        int begin;
+        int end;
+        std::atomic<int>* remaining;
+    };
+
+    // Fixed-capacity ring of tasks; push fails when full
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        int head = 0;   // Front of the ring
+        int count = 0;
+
+        explicit WorkQueue(int capacity) : tasks(capacity) {}
+        bool pushBack(const Task& task);
+        bool popBack(Task& task);
+        bool popFront(Task& task);
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;  // One per worker
+    std::vector<std::thread> workers;
+    std::atomic<int> queued;      // Tasks waiting in any queue
+    std::atomic<unsigned> nextQueue;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping;
+
+    void run(int count, int grain, const Body& body);
+    bool popLocal(int index, Task& task);
+    bool steal(int thief, Task& task);
+    void run(const Task& task);
+    void workerLoop(int index);
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,90 @@
+#ifndef TRAIL_BUFFER_H
+#define TRAIL_BUFFER_H
+
+#include <cstdint>
+#include <vector>
+#include "Types.h"
+
+// Pen history stored as a ring of fixed-size chunks, allocated once.
+// add() only keeps a point once the pen has moved or turned far enough, so the
+// trail covers the same stretch of curve at any frame rate. A full ring drops
+// its oldest chunk whole: every chunk then holds a contiguous run of points and
+// carries a version that changes whenever it does, so a renderer can re-upload
+// just the chunks that changed.
+class TrailBuffer {
+public:
+    static const int CHUNK_SIZE = 64;
+
+    // Capacity is rounded up to whole chunks (at least two)
+    explicit TrailBuffer(int capacity);
+
+    // A point is kept once it is minDistance from the last kept point, or once
+    // the direction has turned by maxTurn radians (after at least a quarter of
+    // minDistance). Zero for both keeps every point.
+    void setSpacing(float minDistance, float maxTurn);
+
+    // Closed mode records one period of the curve and then stops growing; the
+    // renderer joins its ends. Curves longer than capacity points lose their start.
+    void setClosed(bool closed);
+    bool isClosed() const { return closed; }
+
+    // Closed mode: a whole period has been recorded
+    bool isComplete() const { return complete; }
+
+    // Offer the pen position at curve time t (periods). Returns true if kept.
+    bool add(const Point2D& point, double t = 0.0);
+
+    // Append unconditionally, dropping the oldest chunk when full
+    void push(const Point2D& point);
+
+    // Remove all points (keeps storage)
+    void clear();
+
+    // Point i, oldest first
+    const Point2D& operator[](int i) const;
+
+    int size() const;
+    int capacity() const { return static_cast<int>(points.size()); }
+    bool empty() const { return usedChunks == 0; }
+
+    // Chunk view for incremental uploads. Chunk c holds storage points
+    // [c * CHUNK_SIZE, c * CHUNK_SIZE + chunkSize(c)); the used chunks run from
+    // oldestChunk() forward, wrapping, and all but the newest are full.
+    int chunkCount() const { return static_cast<int>(versions.size()); }
+    int oldestChunk() const { return headChunk; }
+    int usedChunkCount() const { return usedChunks; }
+    int chunkSize(int chunk) const;
+    const Point2D* chunkPoints(int chunk) const { return points.data() + chunk * CHUNK_SIZE; }
+
+    // Next chunk in order, or -1 for the newest
+    int nextChunk(int chunk) const;
+
+    // Sequence number of the chunk's first point (points are numbered from 0
+    // for the lifetime of the buffer)
+    std::uint64_t chunkSequence(int chunk) const { return sequences[chunk]; }
+    std::uint64_t chunkVersion(int chunk) const { return versions[chunk]; }
+    std::uint64_t newestSequence() const { return nextSequence - 1; }
+
+    // Unique per buffer, so renderers can tell trails apart
+    std::uint64_t getId() const { return id; }
+
+private:
+    std::vector<Point2D> points;
+    std::vector<std::uint64_t> sequences;
+    std::vector<std::uint64_t> versions;
+    int headChunk;    // Oldest chunk
+    int usedChunks;
+    int newestFill;   // Points in the newest chunk
+    std::uint64_t nextSequence;
+    std::uint64_t id;
+
+    float minDistance;
+    float maxTurn;
+    bool closed;
+    bool complete;
+    double startTime;     // Closed mode: curve time of the first point
+    Point2D direction;    // Unit direction into the last kept point
+    bool hasDirection;
+};
+
+#endif // TRAIL_BUFFER_H
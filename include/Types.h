@@ -7,7 +7,7 @@
 struct Point2D {
     float x, y;
 
-    Point2D(float x = 0.f, float y = 0.f) : x(x), y(y) {}
+    constexpr Point2D(float x = 0.f, float y = 0.f) : x(x), y(y) {}
 
     // Convert to SFML Vector2f
     sf::Vector2f toSFML() const {
@@ -3,6 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <vector>
+#include "Profiler.h"
 
 class UIManager {
 public:
@@ -12,14 +14,33 @@ public:
     bool loadFont(const std::string& fontPath);
 
     // Draw a semi-transparent panel
-    void drawPanel(sf::RenderWindow& window, float x, float y, float width, float height);
+    void drawPanel(sf::RenderTarget& target, float x, float y, float width, float height);
 
-    // Draw text at a position
-    void drawText(sf::RenderWindow& window, const std::string& text, float x, float y, unsigned int size = 14);
+    // Draw text at a position. Text objects are cached per position, so a label that
+    // doesn't change between frames is drawn without rebuilding or allocating.
+    void drawText(sf::RenderTarget& target, const std::string& text, float x, float y, unsigned int size = 14);
+
+    // Draw a panel with min/avg/p99 milliseconds per profiler zone. The numbers
+    // refresh a few times a second so they stay readable.
+    void drawProfiler(sf::RenderTarget& target, const Profiler& profiler, float x, float y);
 
 private:
+    // One cached label per drawText call site
+    struct TextSlot {
+        float x, y;
+        unsigned int size;
+        std::string text;
+        sf::Text label;
+    };
+
     sf::Font font;
     bool fontLoaded;
+    sf::RectangleShape panel;
+    std::vector<TextSlot> textSlots;
+
+    // Profiler overlay lines, rebuilt every PROFILER_REFRESH_FRAMES draws
+    std::vector<std::string> profilerLines;
+    int profilerFrames;
 };
 
 #endif // UI_MANAGER_H
@@ -0,0 +1,85 @@
+#include "AllocationCounter.h"
+#include <atomic>
+
+#ifdef FOURIER_TRACK_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace {
+
+std::atomic<std::size_t> allocationCount{0};
+std::atomic<std::size_t> allocationBytes{0};
+
+} // namespace
+
+namespace AllocationCounter {
+
+bool enabled() {
+#ifdef FOURIER_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::size_t count() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+std::size_t bytes() {
+    return allocationBytes.load(std::memory_order_relaxed);
+}
+
+} // namespace AllocationCounter
+
+#ifdef FOURIER_TRACK_ALLOCATIONS
+
+namespace {
+
+void* countedAlloc(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(std::size_t size, std::align_val_t align) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t alignment = static_cast<std::size_t>(align);
+#ifdef _WIN32
+    if (void* p = _aligned_malloc(size ? size : 1, alignment)) return p;
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    std::size_t rounded = ((size ? size : 1) + alignment - 1) / alignment * alignment;
+    if (void* p = std::aligned_alloc(alignment, rounded)) return p;
+#endif
+    throw std::bad_alloc();
+}
+
+void countedAlignedFree(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+
+#endif // FOURIER_TRACK_ALLOCATIONS
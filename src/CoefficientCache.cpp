@@ -0,0 +1,209 @@
+#include "CoefficientCache.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const char CACHE_MAGIC[4] = {'F', 'C', 'C', 'F'};
+const std::uint32_t CACHE_VERSION = 1;
+const char* CACHE_EXTENSION = ".fcc";
+
+struct CacheHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t key;
+    std::uint64_t pointCount;
+    std::uint64_t count;
+    std::uint64_t sortedCount;
+    std::uint64_t checksum;
+    std::uint8_t reserved[16];
+};
+static_assert(sizeof(CacheHeader) == 64, "Cache header layout is part of the file format");
+
+// Bytes per coefficient: re, im, radius, phase as float64 plus an int32 frequency
+const std::size_t BYTES_PER_COEFFICIENT = 4 * sizeof(double) + sizeof(std::int32_t);
+
+const std::uint64_t HASH_OFFSET = 14695981039346656037ull;
+const std::uint64_t HASH_PRIME = 1099511628211ull;
+
+// FNV-1a over 64-bit words (the tail byte-wise), fast enough to verify
+// multi-million-coefficient files on every load
+std::uint64_t hashBytes(const void* data, std::size_t size, std::uint64_t hash = HASH_OFFSET) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::size_t words = size / sizeof(std::uint64_t);
+    for (std::size_t i = 0; i < words; i++) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+        hash = (hash ^ word) * HASH_PRIME;
+    }
+    for (std::size_t i = words * sizeof(std::uint64_t); i < size; i++) {
+        hash = (hash ^ bytes[i]) * HASH_PRIME;
+    }
+    return hash;
+}
+
+} // namespace
+
+CoefficientCache::CoefficientCache(const std::string& directory, std::uint64_t maxBytes)
+    : directory(directory), maxBytes(maxBytes) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Failed to create cache directory " << directory << ": " << error.message() << std::endl;
+    }
+}
+
+std::uint64_t CoefficientCache::hashPath(const Point2D* points, std::size_t count) {
+    std::uint64_t length = count;
+    std::uint64_t hash = hashBytes(&length, sizeof(length));
+    return hashBytes(points, count * sizeof(Point2D), hash);
+}
+
+std::string CoefficientCache::fileFor(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / (std::string(name) + CACHE_EXTENSION)).string();
+}
+
+bool CoefficientCache::load(std::uint64_t key, std::size_t pointCount, CoefficientStore& out) {
+    std::string filename = fileFor(key);
+    std::error_code error;
+    if (!std::filesystem::exists(filename, error)) return false;
+
+    MappedFile file;
+    if (!file.open(filename)) return false;
+
+    CacheHeader header;
+    bool valid = file.size() >= sizeof(header);
+    std::uint64_t count = 0;
+    if (valid) {
+        std::memcpy(&header, file.data(), sizeof(header));
+        count = header.count;
+        valid = std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                header.version == CACHE_VERSION && header.key == key &&
+                header.pointCount == pointCount && header.sortedCount <= count &&
+                count <= (file.size() - sizeof(header)) / BYTES_PER_COEFFICIENT &&
+                file.size() - sizeof(header) == count * BYTES_PER_COEFFICIENT;
+    }
+    const char* payload = file.data() + sizeof(header);
+    if (valid) {
+        valid = hashBytes(payload, count * BYTES_PER_COEFFICIENT) == header.checksum;
+    }
+    if (!valid) {
+        std::cerr << "Discarding invalid cache file " << filename << std::endl;
+        file.close();
+        std::filesystem::remove(filename, error);
+        return false;
+    }
+
+    // Sections follow each other in header order
+    std::size_t n = static_cast<std::size_t>(count);
+    out.resize(n);
+    const char* section = payload;
+    for (AlignedVector<double>* array : {&out.re, &out.im, &out.radius, &out.phase}) {
+        std::memcpy(array->data(), section, n * sizeof(double));
+        section += n * sizeof(double);
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        std::int32_t frequency;
+        std::memcpy(&frequency, section + i * sizeof(frequency), sizeof(frequency));
+        out.frequency[i] = frequency;
+    }
+    out.sortedCount = static_cast<std::size_t>(header.sortedCount);
+    out.updatePrefixMaxFrequency();
+
+    // Mark as recently used for trimming
+    std::filesystem::last_write_time(filename, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+bool CoefficientCache::save(std::uint64_t key, std::size_t pointCount, const CoefficientStore& coeffs) {
+    std::size_t n = coeffs.size();
+    std::vector<std::int32_t> frequencies(coeffs.frequency.begin(), coeffs.frequency.end());
+
+    CacheHeader header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.pointCount = pointCount;
+    header.count = n;
+    header.sortedCount = coeffs.sortedCount;
+
+    // Checksum the sections in file order without assembling the payload
+    std::uint64_t checksum = HASH_OFFSET;
+    const AlignedVector<double>* sections[] = {&coeffs.re, &coeffs.im, &coeffs.radius, &coeffs.phase};
+    for (const AlignedVector<double>* array : sections) {
+        checksum = hashBytes(array->data(), n * sizeof(double), checksum);
+    }
+    checksum = hashBytes(frequencies.data(), n * sizeof(std::int32_t), checksum);
+    header.checksum = checksum;
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    // Write beside the final name and rename, so readers never see a partial file
+    std::string filename = fileFor(key);
+    std::string temporary = filename + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to create cache file " << temporary << std::endl;
+        return false;
+    }
+    std::fwrite(&header, sizeof(header), 1, file);
+    for (const AlignedVector<double>* array : sections) {
+        std::fwrite(array->data(), sizeof(double), n, file);
+    }
+    std::fwrite(frequencies.data(), sizeof(std::int32_t), n, file);
+    bool written = !std::ferror(file);
+    if (std::fclose(file) != 0 || !written) {
+        std::cerr << "Failed to write cache file " << temporary << std::endl;
+        std::error_code error;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, filename, error);
+    if (error) {
+        std::cerr << "Failed to store cache file " << filename << ": " << error.message() << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+
+    trim();
+    return true;
+}
+
+void CoefficientCache::trim() {
+    struct Entry {
+        std::filesystem::file_time_type time;
+        std::uintmax_t size;
+        std::filesystem::path path;
+    };
+
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory, error)) {
+        if (item.path().extension() != CACHE_EXTENSION) continue;
+        std::error_code itemError;
+        std::uintmax_t size = item.file_size(itemError);
+        std::filesystem::file_time_type time = item.last_write_time(itemError);
+        if (itemError) continue;
+        entries.push_back({time, size, item.path()});
+        total += size;
+    }
+    if (total <= maxBytes) return;
+
+    // Least recently used first
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (const Entry& entry : entries) {
+        if (total <= maxBytes) break;
+        if (std::filesystem::remove(entry.path, error)) total -= entry.size;
+    }
+}
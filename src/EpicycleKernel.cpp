@@ -0,0 +1,554 @@
+#include "EpicycleKernel.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define EPICYCLE_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace EpicycleKernel {
+
+namespace {
+
+// ---- Scalar reference (double and float) -----------------------------------
+
+template <typename Real>
+void chainScalar(const Real* cRe, const Real* cIm, const Real* pRe, const Real* pIm,
+                 int begin, int n, Real& x, Real& y, Real* centerX, Real* centerY) {
+    for (int i = begin; i < n; i++) {
+        centerX[i] = x;
+        centerY[i] = y;
+        x += cRe[i] * pRe[i] - cIm[i] * pIm[i];
+        y += cRe[i] * pIm[i] + cIm[i] * pRe[i];
+    }
+}
+
+template <typename Real>
+void sumScalar(const Real* cRe, const Real* cIm, const Real* pRe, const Real* pIm,
+               int begin, int n, Real& x, Real& y) {
+    for (int i = begin; i < n; i++) {
+        x += cRe[i] * pRe[i] - cIm[i] * pIm[i];
+        y += cRe[i] * pIm[i] + cIm[i] * pRe[i];
+    }
+}
+
+template <typename Real>
+void advanceScalar(Real* pRe, Real* pIm, const Real* sRe, const Real* sIm, int begin, int n) {
+    for (int i = begin; i < n; i++) {
+        Real re = pRe[i] * sRe[i] - pIm[i] * sIm[i];
+        Real im = pRe[i] * sIm[i] + pIm[i] * sRe[i];
+        pRe[i] = re;
+        pIm[i] = im;
+    }
+}
+
+template <typename Real>
+void renormalizeScalar(Real* pRe, Real* pIm, int begin, int n) {
+    for (int i = begin; i < n; i++) {
+        Real scale = Real(0.5) * (Real(3) - (pRe[i] * pRe[i] + pIm[i] * pIm[i]));
+        pRe[i] *= scale;
+        pIm[i] *= scale;
+    }
+}
+
+#ifdef EPICYCLE_KERNEL_X86
+
+// ---- SSE2 (2 lanes, baseline on x86-64) -----------------------------------
+
+__attribute__((target("sse2")))
+void chainSSE2(const double* cRe, const double* cIm, const double* pRe, const double* pIm, int n,
+               double& x, double& y, double* centerX, double* centerY) {
+    const __m128d zero = _mm_setzero_pd();
+    __m128d carryX = _mm_set1_pd(x);
+    __m128d carryY = _mm_set1_pd(y);
+
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d cr = _mm_loadu_pd(cRe + i), ci = _mm_loadu_pd(cIm + i);
+        __m128d pr = _mm_loadu_pd(pRe + i), pi = _mm_loadu_pd(pIm + i);
+        __m128d rx = _mm_sub_pd(_mm_mul_pd(cr, pr), _mm_mul_pd(ci, pi));
+        __m128d ry = _mm_add_pd(_mm_mul_pd(cr, pi), _mm_mul_pd(ci, pr));
+
+        // Exclusive scan within the register: [0, a]
+        __m128d exX = _mm_unpacklo_pd(zero, rx);
+        __m128d exY = _mm_unpacklo_pd(zero, ry);
+        _mm_storeu_pd(centerX + i, _mm_add_pd(carryX, exX));
+        _mm_storeu_pd(centerY + i, _mm_add_pd(carryY, exY));
+
+        // Carry += a + b
+        __m128d totX = _mm_add_pd(rx, _mm_shuffle_pd(rx, rx, 1));
+        __m128d totY = _mm_add_pd(ry, _mm_shuffle_pd(ry, ry, 1));
+        carryX = _mm_add_pd(carryX, totX);
+        carryY = _mm_add_pd(carryY, totY);
+    }
+
+    x = _mm_cvtsd_f64(carryX);
+    y = _mm_cvtsd_f64(carryY);
+    chainScalar(cRe, cIm, pRe, pIm, i, n, x, y, centerX, centerY);
+}
+
+__attribute__((target("sse2")))
+void sumSSE2(const double* cRe, const double* cIm, const double* pRe, const double* pIm, int n,
+             double& x, double& y) {
+    __m128d accX = _mm_setzero_pd();
+    __m128d accY = _mm_setzero_pd();
+
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d cr = _mm_loadu_pd(cRe + i), ci = _mm_loadu_pd(cIm + i);
+        __m128d pr = _mm_loadu_pd(pRe + i), pi = _mm_loadu_pd(pIm + i);
+        accX = _mm_add_pd(accX, _mm_sub_pd(_mm_mul_pd(cr, pr), _mm_mul_pd(ci, pi)));
+        accY = _mm_add_pd(accY, _mm_add_pd(_mm_mul_pd(cr, pi), _mm_mul_pd(ci, pr)));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, accX);
+    x += lanes[0] + lanes[1];
+    _mm_storeu_pd(lanes, accY);
+    y += lanes[0] + lanes[1];
+    sumScalar(cRe, cIm, pRe, pIm, i, n, x, y);
+}
+
+__attribute__((target("sse2")))
+void advanceSSE2(double* pRe, double* pIm, const double* sRe, const double* sIm, int n) {
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d pr = _mm_loadu_pd(pRe + i), pi = _mm_loadu_pd(pIm + i);
+        __m128d sr = _mm_loadu_pd(sRe + i), si = _mm_loadu_pd(sIm + i);
+        _mm_storeu_pd(pRe + i, _mm_sub_pd(_mm_mul_pd(pr, sr), _mm_mul_pd(pi, si)));
+        _mm_storeu_pd(pIm + i, _mm_add_pd(_mm_mul_pd(pr, si), _mm_mul_pd(pi, sr)));
+    }
+    advanceScalar(pRe, pIm, sRe, sIm, i, n);
+}
+
+__attribute__((target("sse2")))
+void renormalizeSSE2(double* pRe, double* pIm, int n) {
+    const __m128d half = _mm_set1_pd(0.5), three = _mm_set1_pd(3.0);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d pr = _mm_loadu_pd(pRe + i), pi = _mm_loadu_pd(pIm + i);
+        __m128d norm = _mm_add_pd(_mm_mul_pd(pr, pr), _mm_mul_pd(pi, pi));
+        __m128d scale = _mm_mul_pd(half, _mm_sub_pd(three, norm));
+        _mm_storeu_pd(pRe + i, _mm_mul_pd(pr, scale));
+        _mm_storeu_pd(pIm + i, _mm_mul_pd(pi, scale));
+    }
+    renormalizeScalar(pRe, pIm, i, n);
+}
+
+// ---- AVX2 (4 lanes) --------------------------------------------------------
+
+// Inclusive prefix sum across the 4 lanes: [a, a+b, a+b+c, a+b+c+d]
+__attribute__((target("avx2")))
+inline __m256d scan4(__m256d v) {
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d shift1 = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1);
+    v = _mm256_add_pd(v, shift1);
+    __m256d shift2 = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3);
+    return _mm256_add_pd(v, shift2);
+}
+
+__attribute__((target("avx2")))
+void chainAVX2(const double* cRe, const double* cIm, const double* pRe, const double* pIm, int n,
+               double& x, double& y, double* centerX, double* centerY) {
+    __m256d carryX = _mm256_set1_pd(x);
+    __m256d carryY = _mm256_set1_pd(y);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d cr = _mm256_loadu_pd(cRe + i), ci = _mm256_loadu_pd(cIm + i);
+        __m256d pr = _mm256_loadu_pd(pRe + i), pi = _mm256_loadu_pd(pIm + i);
+        __m256d rx = _mm256_sub_pd(_mm256_mul_pd(cr, pr), _mm256_mul_pd(ci, pi));
+        __m256d ry = _mm256_add_pd(_mm256_mul_pd(cr, pi), _mm256_mul_pd(ci, pr));
+
+        __m256d incX = scan4(rx);
+        __m256d incY = scan4(ry);
+
+        // Centers are the exclusive scan: everything before this term
+        _mm256_storeu_pd(centerX + i, _mm256_add_pd(carryX, _mm256_sub_pd(incX, rx)));
+        _mm256_storeu_pd(centerY + i, _mm256_add_pd(carryY, _mm256_sub_pd(incY, ry)));
+
+        carryX = _mm256_add_pd(carryX, _mm256_permute4x64_pd(incX, _MM_SHUFFLE(3, 3, 3, 3)));
+        carryY = _mm256_add_pd(carryY, _mm256_permute4x64_pd(incY, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+
+    x = _mm256_cvtsd_f64(carryX);
+    y = _mm256_cvtsd_f64(carryY);
+    _mm256_zeroupper();  // Clean upper halves, or the SSE code that follows stalls
+    chainScalar(cRe, cIm, pRe, pIm, i, n, x, y, centerX, centerY);
+}
+
+__attribute__((target("avx2")))
+void sumAVX2(const double* cRe, const double* cIm, const double* pRe, const double* pIm, int n,
+             double& x, double& y) {
+    __m256d accX = _mm256_setzero_pd();
+    __m256d accY = _mm256_setzero_pd();
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d cr = _mm256_loadu_pd(cRe + i), ci = _mm256_loadu_pd(cIm + i);
+        __m256d pr = _mm256_loadu_pd(pRe + i), pi = _mm256_loadu_pd(pIm + i);
+        accX = _mm256_add_pd(accX, _mm256_sub_pd(_mm256_mul_pd(cr, pr), _mm256_mul_pd(ci, pi)));
+        accY = _mm256_add_pd(accY, _mm256_add_pd(_mm256_mul_pd(cr, pi), _mm256_mul_pd(ci, pr)));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, accX);
+    x += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm256_storeu_pd(lanes, accY);
+    y += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm256_zeroupper();
+    sumScalar(cRe, cIm, pRe, pIm, i, n, x, y);
+}
+
+__attribute__((target("avx2")))
+void advanceAVX2(double* pRe, double* pIm, const double* sRe, const double* sIm, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d pr = _mm256_loadu_pd(pRe + i), pi = _mm256_loadu_pd(pIm + i);
+        __m256d sr = _mm256_loadu_pd(sRe + i), si = _mm256_loadu_pd(sIm + i);
+        _mm256_storeu_pd(pRe + i, _mm256_sub_pd(_mm256_mul_pd(pr, sr), _mm256_mul_pd(pi, si)));
+        _mm256_storeu_pd(pIm + i, _mm256_add_pd(_mm256_mul_pd(pr, si), _mm256_mul_pd(pi, sr)));
+    }
+    _mm256_zeroupper();
+    advanceScalar(pRe, pIm, sRe, sIm, i, n);
+}
+
+__attribute__((target("avx2")))
+void renormalizeAVX2(double* pRe, double* pIm, int n) {
+    const __m256d half = _mm256_set1_pd(0.5), three = _mm256_set1_pd(3.0);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d pr = _mm256_loadu_pd(pRe + i), pi = _mm256_loadu_pd(pIm + i);
+        __m256d norm = _mm256_add_pd(_mm256_mul_pd(pr, pr), _mm256_mul_pd(pi, pi));
+        __m256d scale = _mm256_mul_pd(half, _mm256_sub_pd(three, norm));
+        _mm256_storeu_pd(pRe + i, _mm256_mul_pd(pr, scale));
+        _mm256_storeu_pd(pIm + i, _mm256_mul_pd(pi, scale));
+    }
+    _mm256_zeroupper();
+    renormalizeScalar(pRe, pIm, i, n);
+}
+
+// ---- SSE2 float (4 lanes) --------------------------------------------------
+
+// Inclusive prefix sum across the 4 lanes
+__attribute__((target("sse2")))
+inline __m128 scan4(__m128 v) {
+    v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+    return _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+}
+
+__attribute__((target("sse2")))
+void chainSSE2(const float* cRe, const float* cIm, const float* pRe, const float* pIm, int n,
+               float& x, float& y, float* centerX, float* centerY) {
+    __m128 carryX = _mm_set1_ps(x);
+    __m128 carryY = _mm_set1_ps(y);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 cr = _mm_loadu_ps(cRe + i), ci = _mm_loadu_ps(cIm + i);
+        __m128 pr = _mm_loadu_ps(pRe + i), pi = _mm_loadu_ps(pIm + i);
+        __m128 rx = _mm_sub_ps(_mm_mul_ps(cr, pr), _mm_mul_ps(ci, pi));
+        __m128 ry = _mm_add_ps(_mm_mul_ps(cr, pi), _mm_mul_ps(ci, pr));
+
+        __m128 incX = scan4(rx);
+        __m128 incY = scan4(ry);
+        _mm_storeu_ps(centerX + i, _mm_add_ps(carryX, _mm_sub_ps(incX, rx)));
+        _mm_storeu_ps(centerY + i, _mm_add_ps(carryY, _mm_sub_ps(incY, ry)));
+
+        carryX = _mm_add_ps(carryX, _mm_shuffle_ps(incX, incX, _MM_SHUFFLE(3, 3, 3, 3)));
+        carryY = _mm_add_ps(carryY, _mm_shuffle_ps(incY, incY, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+
+    x = _mm_cvtss_f32(carryX);
+    y = _mm_cvtss_f32(carryY);
+    chainScalar(cRe, cIm, pRe, pIm, i, n, x, y, centerX, centerY);
+}
+
+__attribute__((target("sse2")))
+void sumSSE2(const float* cRe, const float* cIm, const float* pRe, const float* pIm, int n,
+             float& x, float& y) {
+    __m128 accX = _mm_setzero_ps();
+    __m128 accY = _mm_setzero_ps();
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 cr = _mm_loadu_ps(cRe + i), ci = _mm_loadu_ps(cIm + i);
+        __m128 pr = _mm_loadu_ps(pRe + i), pi = _mm_loadu_ps(pIm + i);
+        accX = _mm_add_ps(accX, _mm_sub_ps(_mm_mul_ps(cr, pr), _mm_mul_ps(ci, pi)));
+        accY = _mm_add_ps(accY, _mm_add_ps(_mm_mul_ps(cr, pi), _mm_mul_ps(ci, pr)));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, accX);
+    x += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm_storeu_ps(lanes, accY);
+    y += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    sumScalar(cRe, cIm, pRe, pIm, i, n, x, y);
+}
+
+__attribute__((target("sse2")))
+void advanceSSE2(float* pRe, float* pIm, const float* sRe, const float* sIm, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 pr = _mm_loadu_ps(pRe + i), pi = _mm_loadu_ps(pIm + i);
+        __m128 sr = _mm_loadu_ps(sRe + i), si = _mm_loadu_ps(sIm + i);
+        _mm_storeu_ps(pRe + i, _mm_sub_ps(_mm_mul_ps(pr, sr), _mm_mul_ps(pi, si)));
+        _mm_storeu_ps(pIm + i, _mm_add_ps(_mm_mul_ps(pr, si), _mm_mul_ps(pi, sr)));
+    }
+    advanceScalar(pRe, pIm, sRe, sIm, i, n);
+}
+
+__attribute__((target("sse2")))
+void renormalizeSSE2(float* pRe, float* pIm, int n) {
+    const __m128 half = _mm_set1_ps(0.5f), three = _mm_set1_ps(3.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 pr = _mm_loadu_ps(pRe + i), pi = _mm_loadu_ps(pIm + i);
+        __m128 norm = _mm_add_ps(_mm_mul_ps(pr, pr), _mm_mul_ps(pi, pi));
+        __m128 scale = _mm_mul_ps(half, _mm_sub_ps(three, norm));
+        _mm_storeu_ps(pRe + i, _mm_mul_ps(pr, scale));
+        _mm_storeu_ps(pIm + i, _mm_mul_ps(pi, scale));
+    }
+    renormalizeScalar(pRe, pIm, i, n);
+}
+
+// ---- AVX2 float (8 lanes) --------------------------------------------------
+
+// Inclusive prefix sum across the 8 lanes: scan each 128-bit half, then add
+// the low half's total to the high half
+__attribute__((target("avx2")))
+inline __m256 scan8(__m256 v) {
+    v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 4)));
+    v = _mm256_add_ps(v, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(v), 8)));
+    __m256 halfTotals = _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_ps(v, _mm256_permute2f128_ps(halfTotals, halfTotals, 0x08));
+}
+
+__attribute__((target("avx2")))
+void chainAVX2(const float* cRe, const float* cIm, const float* pRe, const float* pIm, int n,
+               float& x, float& y, float* centerX, float* centerY) {
+    const __m256i last = _mm256_set1_epi32(7);
+    __m256 carryX = _mm256_set1_ps(x);
+    __m256 carryY = _mm256_set1_ps(y);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 cr = _mm256_loadu_ps(cRe + i), ci = _mm256_loadu_ps(cIm + i);
+        __m256 pr = _mm256_loadu_ps(pRe + i), pi = _mm256_loadu_ps(pIm + i);
+        __m256 rx = _mm256_sub_ps(_mm256_mul_ps(cr, pr), _mm256_mul_ps(ci, pi));
+        __m256 ry = _mm256_add_ps(_mm256_mul_ps(cr, pi), _mm256_mul_ps(ci, pr));
+
+        __m256 incX = scan8(rx);
+        __m256 incY = scan8(ry);
+        _mm256_storeu_ps(centerX + i, _mm256_add_ps(carryX, _mm256_sub_ps(incX, rx)));
+        _mm256_storeu_ps(centerY + i, _mm256_add_ps(carryY, _mm256_sub_ps(incY, ry)));
+
+        carryX = _mm256_add_ps(carryX, _mm256_permutevar8x32_ps(incX, last));
+        carryY = _mm256_add_ps(carryY, _mm256_permutevar8x32_ps(incY, last));
+    }
+
+    x = _mm256_cvtss_f32(carryX);
+    y = _mm256_cvtss_f32(carryY);
+    _mm256_zeroupper();
+    chainScalar(cRe, cIm, pRe, pIm, i, n, x, y, centerX, centerY);
+}
+
+__attribute__((target("avx2")))
+void sumAVX2(const float* cRe, const float* cIm, const float* pRe, const float* pIm, int n,
+             float& x, float& y) {
+    __m256 accX = _mm256_setzero_ps();
+    __m256 accY = _mm256_setzero_ps();
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 cr = _mm256_loadu_ps(cRe + i), ci = _mm256_loadu_ps(cIm + i);
+        __m256 pr = _mm256_loadu_ps(pRe + i), pi = _mm256_loadu_ps(pIm + i);
+        accX = _mm256_add_ps(accX, _mm256_sub_ps(_mm256_mul_ps(cr, pr), _mm256_mul_ps(ci, pi)));
+        accY = _mm256_add_ps(accY, _mm256_add_ps(_mm256_mul_ps(cr, pi), _mm256_mul_ps(ci, pr)));
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, accX);
+    x += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    _mm256_storeu_ps(lanes, accY);
+    y += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    _mm256_zeroupper();
+    sumScalar(cRe, cIm, pRe, pIm, i, n, x, y);
+}
+
+__attribute__((target("avx2")))
+void advanceAVX2(float* pRe, float* pIm, const float* sRe, const float* sIm, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 pr = _mm256_loadu_ps(pRe + i), pi = _mm256_loadu_ps(pIm + i);
+        __m256 sr = _mm256_loadu_ps(sRe + i), si = _mm256_loadu_ps(sIm + i);
+        _mm256_storeu_ps(pRe + i, _mm256_sub_ps(_mm256_mul_ps(pr, sr), _mm256_mul_ps(pi, si)));
+        _mm256_storeu_ps(pIm + i, _mm256_add_ps(_mm256_mul_ps(pr, si), _mm256_mul_ps(pi, sr)));
+    }
+    _mm256_zeroupper();
+    advanceScalar(pRe, pIm, sRe, sIm, i, n);
+}
+
+__attribute__((target("avx2")))
+void renormalizeAVX2(float* pRe, float* pIm, int n) {
+    const __m256 half = _mm256_set1_ps(0.5f), three = _mm256_set1_ps(3.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 pr = _mm256_loadu_ps(pRe + i), pi = _mm256_loadu_ps(pIm + i);
+        __m256 norm = _mm256_add_ps(_mm256_mul_ps(pr, pr), _mm256_mul_ps(pi, pi));
+        __m256 scale = _mm256_mul_ps(half, _mm256_sub_ps(three, norm));
+        _mm256_storeu_ps(pRe + i, _mm256_mul_ps(pr, scale));
+        _mm256_storeu_ps(pIm + i, _mm256_mul_ps(pi, scale));
+    }
+    _mm256_zeroupper();
+    renormalizeScalar(pRe, pIm, i, n);
+}
+
+#endif // EPICYCLE_KERNEL_X86
+
+Isa probeIsa() {
+#ifdef EPICYCLE_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+    if (__builtin_cpu_supports("sse2")) return Isa::SSE2;
+#endif
+    return Isa::Scalar;
+}
+
+Isa& currentIsa() {
+    static Isa isa = detectedIsa();
+    return isa;
+}
+
+} // namespace
+
+Isa detectedIsa() {
+    static const Isa isa = probeIsa();
+    return isa;
+}
+
+Isa activeIsa() {
+    return currentIsa();
+}
+
+void setIsa(Isa isa) {
+    // Never select more than the CPU supports
+    currentIsa() = static_cast<int>(isa) <= static_cast<int>(detectedIsa()) ? isa : detectedIsa();
+}
+
+const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2: return "AVX2";
+        case Isa::SSE2: return "SSE2";
+        default:        return "Scalar";
+    }
+}
+
+void chain(const double* cRe, const double* cIm,
+           const double* pRe, const double* pIm, int n,
+           double originX, double originY,
+           double* centerX, double* centerY,
+           double& tipX, double& tipY) {
+    tipX = originX;
+    tipY = originY;
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: chainAVX2(cRe, cIm, pRe, pIm, n, tipX, tipY, centerX, centerY); return;
+        case Isa::SSE2: chainSSE2(cRe, cIm, pRe, pIm, n, tipX, tipY, centerX, centerY); return;
+        default: break;
+    }
+#endif
+    chainScalar(cRe, cIm, pRe, pIm, 0, n, tipX, tipY, centerX, centerY);
+}
+
+void sum(const double* cRe, const double* cIm,
+         const double* pRe, const double* pIm, int n,
+         double& outX, double& outY) {
+    outX = 0.0;
+    outY = 0.0;
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: sumAVX2(cRe, cIm, pRe, pIm, n, outX, outY); return;
+        case Isa::SSE2: sumSSE2(cRe, cIm, pRe, pIm, n, outX, outY); return;
+        default: break;
+    }
+#endif
+    sumScalar(cRe, cIm, pRe, pIm, 0, n, outX, outY);
+}
+
+void advance(double* pRe, double* pIm, const double* sRe, const double* sIm, int n) {
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: advanceAVX2(pRe, pIm, sRe, sIm, n); return;
+        case Isa::SSE2: advanceSSE2(pRe, pIm, sRe, sIm, n); return;
+        default: break;
+    }
+#endif
+    advanceScalar(pRe, pIm, sRe, sIm, 0, n);
+}
+
+void renormalize(double* pRe, double* pIm, int n) {
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: renormalizeAVX2(pRe, pIm, n); return;
+        case Isa::SSE2: renormalizeSSE2(pRe, pIm, n); return;
+        default: break;
+    }
+#endif
+    renormalizeScalar(pRe, pIm, 0, n);
+}
+
+void chain(const float* cRe, const float* cIm,
+           const float* pRe, const float* pIm, int n,
+           float originX, float originY,
+           float* centerX, float* centerY,
+           float& tipX, float& tipY) {
+    tipX = originX;
+    tipY = originY;
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: chainAVX2(cRe, cIm, pRe, pIm, n, tipX, tipY, centerX, centerY); return;
+        case Isa::SSE2: chainSSE2(cRe, cIm, pRe, pIm, n, tipX, tipY, centerX, centerY); return;
+        default: break;
+    }
+#endif
+    chainScalar(cRe, cIm, pRe, pIm, 0, n, tipX, tipY, centerX, centerY);
+}
+
+void sum(const float* cRe, const float* cIm,
+         const float* pRe, const float* pIm, int n,
+         float& outX, float& outY) {
+    outX = 0.0f;
+    outY = 0.0f;
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: sumAVX2(cRe, cIm, pRe, pIm, n, outX, outY); return;
+        case Isa::SSE2: sumSSE2(cRe, cIm, pRe, pIm, n, outX, outY); return;
+        default: break;
+    }
+#endif
+    sumScalar(cRe, cIm, pRe, pIm, 0, n, outX, outY);
+}
+
+void advance(float* pRe, float* pIm, const float* sRe, const float* sIm, int n) {
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: advanceAVX2(pRe, pIm, sRe, sIm, n); return;
+        case Isa::SSE2: advanceSSE2(pRe, pIm, sRe, sIm, n); return;
+        default: break;
+    }
+#endif
+    advanceScalar(pRe, pIm, sRe, sIm, 0, n);
+}
+
+void renormalize(float* pRe, float* pIm, int n) {
+#ifdef EPICYCLE_KERNEL_X86
+    switch (activeIsa()) {
+        case Isa::AVX2: renormalizeAVX2(pRe, pIm, n); return;
+        case Isa::SSE2: renormalizeSSE2(pRe, pIm, n); return;
+        default: break;
+    }
+#endif
+    renormalizeScalar(pRe, pIm, 0, n);
+}
+
+} // namespace EpicycleKernel
@@ -0,0 +1,250 @@
+#include "FFTPlan.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const double TWO_PI = 2.0 * M_PI;
+
+// Largest prime the mixed-radix path handles directly; bigger factors use Bluestein
+const int MAX_MIXED_RADIX_PRIME = 13;
+
+bool isPowerOfTwo(int n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+// Split n into radices (4s first, then small primes). Returns false if a
+// prime factor larger than MAX_MIXED_RADIX_PRIME remains.
+bool factorize(int n, std::vector<int>& factors) {
+    factors.clear();
+    while (n % 4 == 0) {
+        factors.push_back(4);
+        n /= 4;
+    }
+    for (int p = 2; p <= MAX_MIXED_RADIX_PRIME; p++) {
+        while (n % p == 0) {
+            factors.push_back(p);
+            n /= p;
+        }
+    }
+    return n == 1;
+}
+
+} // namespace
+
+int FFTPlan::fastSize(int n) {
+    for (int m = std::max(n, 1); ; m++) {
+        int rest = m;
+        for (int p : {2, 3, 5}) {
+            while (rest % p == 0) rest /= p;
+        }
+        if (rest == 1) return m;
+    }
+}
+
+FFTPlan::FFTPlan(int n) : n(n), algo(Algorithm::Radix4) {
+    if (n <= 0) {
+        this->n = 0;
+        return;
+    }
+
+    twiddles.resize(n);
+    for (int j = 0; j < n; j++) {
+        double angle = -TWO_PI * j / n;
+        twiddles[j] = Complex(std::cos(angle), std::sin(angle));
+    }
+
+    if (isPowerOfTwo(n)) {
+        algo = Algorithm::Radix4;
+        int bits = 0;
+        while ((1 << bits) < n) bits++;
+        bitReverse.resize(n);
+        for (int i = 0; i < n; i++) {
+            int r = 0;
+            for (int b = 0; b < bits; b++) {
+                if (i & (1 << b)) r |= 1 << (bits - 1 - b);
+            }
+            bitReverse[i] = r;
+        }
+    } else if (factorize(n, factors)) {
+        algo = Algorithm::MixedRadix;
+        scratch.resize(n);
+    } else {
+        algo = Algorithm::Bluestein;
+
+        // Convolution length must hold the full linear convolution (2N - 1)
+        int m = 1;
+        while (m < 2 * n - 1) m <<= 1;
+        convolutionPlan = std::make_unique<FFTPlan>(m);
+
+        // n² mod 2N keeps the chirp angle small so it stays accurate for large N
+        chirp.resize(n);
+        long long period = 2LL * n;
+        for (int i = 0; i < n; i++) {
+            long long sq = (static_cast<long long>(i) * i) % period;
+            double angle = -M_PI * static_cast<double>(sq) / n;
+            chirp[i] = Complex(std::cos(angle), std::sin(angle));
+        }
+
+        chirpSpectrum.assign(m, Complex(0.0, 0.0));
+        chirpSpectrum[0] = std::conj(chirp[0]);
+        for (int i = 1; i < n; i++) {
+            chirpSpectrum[i] = std::conj(chirp[i]);
+            chirpSpectrum[m - i] = std::conj(chirp[i]);
+        }
+        convolutionPlan->forward(chirpSpectrum.data());
+
+        scratch.resize(m);
+    }
+}
+
+void FFTPlan::forward(Complex* data) const {
+    if (n <= 1) return;
+
+    switch (algo) {
+        case Algorithm::Radix4:     transformRadix4(data); break;
+        case Algorithm::MixedRadix: transformMixedRadix(data); break;
+        case Algorithm::Bluestein:  transformBluestein(data); break;
+    }
+}
+
+void FFTPlan::inverse(Complex* data) const {
+    // IFFT(x) = conj(FFT(conj(x))), left unnormalized
+    for (int i = 0; i < n; i++) data[i] = std::conj(data[i]);
+    forward(data);
+    for (int i = 0; i < n; i++) data[i] = std::conj(data[i]);
+}
+
+void FFTPlan::transformRadix4(Complex* data) const {
+    for (int i = 0; i < n; i++) {
+        int r = bitReverse[i];
+        if (i < r) std::swap(data[i], data[r]);
+    }
+
+    // With an odd number of bits, do one radix-2 stage first
+    int m = 1;
+    int bits = 0;
+    while ((1 << bits) < n) bits++;
+    if (bits % 2 == 1) {
+        for (int i = 0; i < n; i += 2) {
+            Complex a = data[i];
+            Complex b = data[i + 1];
+            data[i] = a + b;
+            data[i + 1] = a - b;
+        }
+        m = 2;
+    }
+
+    // Each radix-4 pass fuses the radix-2 stages of length 2m and 4m
+    const Complex minusI(0.0, -1.0);
+    for (; 4 * m <= n; m *= 4) {
+        int stride1 = n / (2 * m);
+        int stride2 = n / (4 * m);
+        for (int base = 0; base < n; base += 4 * m) {
+            for (int j = 0; j < m; j++) {
+                Complex w1 = twiddles[j * stride1];
+                Complex w2 = twiddles[j * stride2];
+
+                Complex a = data[base + j];
+                Complex b = w1 * data[base + j + m];
+                Complex c = data[base + j + 2 * m];
+                Complex d = w1 * data[base + j + 3 * m];
+
+                Complex sumAB = a + b;
+                Complex diffAB = a - b;
+                Complex sumCD = w2 * (c + d);
+                Complex diffCD = w2 * (c - d) * minusI;
+
+                data[base + j] = sumAB + sumCD;
+                data[base + j + 2 * m] = sumAB - sumCD;
+                data[base + j + m] = diffAB + diffCD;
+                data[base + j + 3 * m] = diffAB - diffCD;
+            }
+        }
+    }
+}
+
+void FFTPlan::transformMixedRadix(Complex* data) const {
+    std::copy(data, data + n, scratch.begin());
+    mixedRadixStep(data, scratch.data(), 1, n, 0);
+}
+
+void FFTPlan::mixedRadixStep(Complex* out, const Complex* in, int inStride,
+                             int length, int factorIndex) const {
+    // Decimation in time: split into p interleaved sub-sequences of length m
+    int p = factors[factorIndex];
+    int m = length / p;
+
+    if (m == 1) {
+        for (int q = 0; q < p; q++) out[q] = in[q * inStride];
+    } else {
+        for (int q = 0; q < p; q++) {
+            mixedRadixStep(out + q * m, in + q * inStride, inStride * p, m, factorIndex + 1);
+        }
+    }
+
+    // Combine: X[k + q'm] = sum_q W_len^(q*k) * W_p^(q*q') * F_q[k]
+    int twStride = n / length;
+    int rootStride = n / p;
+
+    if (p == 2) {
+        for (int k = 0; k < m; k++) {
+            Complex a = out[k];
+            Complex b = out[k + m] * twiddles[k * twStride];
+            out[k] = a + b;
+            out[k + m] = a - b;
+        }
+        return;
+    }
+
+    if (p == 4) {
+        const Complex minusI(0.0, -1.0);
+        for (int k = 0; k < m; k++) {
+            Complex a = out[k];
+            Complex b = out[k + m] * twiddles[k * twStride];
+            Complex c = out[k + 2 * m] * twiddles[2 * k * twStride];
+            Complex d = out[k + 3 * m] * twiddles[3 * k * twStride];
+
+            Complex sumAC = a + c;
+            Complex diffAC = a - c;
+            Complex sumBD = b + d;
+            Complex diffBD = (b - d) * minusI;
+
+            out[k] = sumAC + sumBD;
+            out[k + m] = diffAC + diffBD;
+            out[k + 2 * m] = sumAC - sumBD;
+            out[k + 3 * m] = diffAC - diffBD;
+        }
+        return;
+    }
+
+    // Generic odd prime radix
+    Complex t[MAX_MIXED_RADIX_PRIME];
+    for (int k = 0; k < m; k++) {
+        for (int q = 0; q < p; q++) {
+            t[q] = out[k + q * m] * twiddles[q * k * twStride];
+        }
+        for (int qOut = 0; qOut < p; qOut++) {
+            Complex sum = t[0];
+            for (int q = 1; q < p; q++) {
+                sum += t[q] * twiddles[((q * qOut) % p) * rootStride];
+            }
+            out[k + qOut * m] = sum;
+        }
+    }
+}
+
+void FFTPlan::transformBluestein(Complex* data) const {
+    int m = convolutionPlan->size();
+
+    // X[k] = chirp[k] * sum_n (x[n] * chirp[n]) * conj(chirp[k - n])
+    for (int i = 0; i < n; i++) scratch[i] = data[i] * chirp[i];
+    std::fill(scratch.begin() + n, scratch.end(), Complex(0.0, 0.0));
+
+    convolutionPlan->forward(scratch.data());
+    for (int i = 0; i < m; i++) scratch[i] *= chirpSpectrum[i];
+    convolutionPlan->inverse(scratch.data());
+
+    double scale = 1.0 / m;
+    for (int i = 0; i < n; i++) data[i] = chirp[i] * scratch[i] * scale;
+}
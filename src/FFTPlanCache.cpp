@@ -0,0 +1,39 @@
+#include "FFTPlanCache.h"
+#include <algorithm>
+
+FFTPlanCache::FFTPlanCache(std::size_t capacity)
+    : maxEntries(std::max<std::size_t>(capacity, 1)), hitCount(0), missCount(0), evictionCount(0) {
+    entries.reserve(maxEntries + 1);
+}
+
+std::shared_ptr<FFTPlan> FFTPlanCache::acquire(int n) {
+    // Only a handful of lengths are ever live, so a linear scan beats hashing
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        if (entries[i]->size() == n) {
+            hitCount++;
+            std::rotate(entries.begin(), entries.begin() + i, entries.begin() + i + 1);
+            return entries.front();
+        }
+    }
+
+    missCount++;
+    entries.insert(entries.begin(), std::make_shared<FFTPlan>(n));
+    evictToCapacity();
+    return entries.front();
+}
+
+void FFTPlanCache::clear() {
+    entries.clear();
+}
+
+void FFTPlanCache::setCapacity(std::size_t capacity) {
+    maxEntries = std::max<std::size_t>(capacity, 1);
+    evictToCapacity();
+}
+
+void FFTPlanCache::evictToCapacity() {
+    while (entries.size() > maxEntries) {
+        entries.pop_back();
+        evictionCount++;
+    }
+}
@@ -1,9 +1,38 @@
 #include "FourierEngine.h"
+#include "CoefficientCache.h"
+#include "EpicycleKernel.h"
+#include "ParallelFFT.h"
+#include "Presets.h"
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
 const double TWO_PI = 2.0 * M_PI;
 
+// Phasor mode tuning: forward steps larger than this (in periods) count as a
+// jump. The precision policy sets how often magnitudes are pulled back to 1
+// and how often a full direct evaluation bounds phase drift.
+const double MAX_PHASOR_STEP = 0.5;
+
+// Triple buffer slot indices fit in the low bits; PUBLISHED_FLAG marks a
+// middle slot the render thread has not picked up yet
+const int SLOT_MASK = 3;
+const int PUBLISHED_FLAG = 4;
+
+// Background paths longer than twice PREVIEW_SIZE first publish a transform of
+// PREVIEW_SIZE resampled points, then PREVIEW_GROWTH times more per step, so the
+// first frame after loading costs the same however long the path is
+const int PREVIEW_SIZE = 1024;
+const int PREVIEW_GROWTH = 16;
+
+// Simulation ticks per second, and the slack that lets an accumulator a
+// rounding error short of a whole tick still take it
+const double DEFAULT_TICK_RATE = 240.0;
+const double TICK_EPSILON = 1e-9;
+
+namespace {
+
 // Structure to store coefficient with its frequency index
 struct CoeffData {
     std::complex<double> coeff;
@@ -11,104 +40,764 @@ struct CoeffData {
     double magnitude;
 };
 
-FourierEngine::FourierEngine() : numEpicycles(0), time(0.0) {
+bool largerMagnitude(const CoeffData& a, const CoeffData& b) {
+    return a.magnitude > b.magnitude;
+}
+
+// Run body over [0, count) on the pool when there is one, else inline
+template <typename Body>
+void forRange(ThreadPool* pool, int count, const Body& body) {
+    if (pool) {
+        pool->parallelFor(count, std::max(1, count / (4 * pool->size())), body);
+    } else {
+        body(0, count);
+    }
+}
+
+// Serial selection: the sortCount largest first, sorted (all of them if sortCount == count)
+void sortLargest(std::vector<CoeffData>& data, int sortCount) {
+    if (sortCount >= static_cast<int>(data.size())) {
+        std::sort(data.begin(), data.end(), largerMagnitude);
+    } else {
+        std::nth_element(data.begin(), data.begin() + sortCount, data.end(), largerMagnitude);
+        std::sort(data.begin(), data.begin() + sortCount, largerMagnitude);
+    }
+}
+
+// Parallel version of sortLargest: one chunk per thread
+void sortLargest(std::vector<CoeffData>& data, int sortCount, ThreadPool& pool) {
+    int count = static_cast<int>(data.size());
+    int chunks = pool.size();
+    int chunkSize = (count + chunks - 1) / chunks;
+    auto chunkBegin = [&](int c) { return data.begin() + std::min(count, c * chunkSize); };
+
+    if (sortCount < count && chunkSize >= 2 * sortCount) {
+        // Each chunk brings its own sortCount largest to its front; the overall
+        // largest are among those winners
+        pool.parallelFor(chunks, 1, [&](int begin, int end) {
+            for (int c = begin; c < end; c++) {
+                if (chunkBegin(c + 1) - chunkBegin(c) > sortCount) {
+                    std::nth_element(chunkBegin(c), chunkBegin(c) + sortCount, chunkBegin(c + 1), largerMagnitude);
+                }
+            }
+        });
+
+        // Pack the winners of chunk c into [c*K, (c+1)*K). Chunks are at least 2K
+        // long, so the target never overlaps winners that are still to be moved.
+        int candidates = 0;
+        for (int c = 0; c < chunks; c++) {
+            int winners = std::min<int>(sortCount, chunkBegin(c + 1) - chunkBegin(c));
+            std::swap_ranges(chunkBegin(c), chunkBegin(c) + winners, data.begin() + candidates);
+            candidates += winners;
+        }
+        std::nth_element(data.begin(), data.begin() + sortCount, data.begin() + candidates, largerMagnitude);
+        std::sort(data.begin(), data.begin() + sortCount, largerMagnitude);
+    } else {
+        // Full sort: sort chunks side by side, then merge pairs of runs
+        pool.parallelFor(chunks, 1, [&](int begin, int end) {
+            for (int c = begin; c < end; c++) {
+                std::sort(chunkBegin(c), chunkBegin(c + 1), largerMagnitude);
+            }
+        });
+        for (int width = 1; width < chunks; width *= 2) {
+            int pairs = (chunks + 2 * width - 1) / (2 * width);
+            pool.parallelFor(pairs, 1, [&](int begin, int end) {
+                for (int p = begin; p < end; p++) {
+                    int first = 2 * width * p;
+                    std::inplace_merge(chunkBegin(first), chunkBegin(std::min(chunks, first + width)),
+                                       chunkBegin(std::min(chunks, first + 2 * width)), largerMagnitude);
+                }
+            });
+        }
+    }
+}
+
+// Transform path into out with the sortCount largest coefficients first, sorted
+// by magnitude (sortCount <= 0 sorts all). Long paths spread the FFT, magnitudes
+// and selection across pool when given. Gives up and returns false as soon as
+// latest no longer matches generation (pass nullptr to never cancel).
+bool transformPath(const std::vector<Point2D>& path, FFTPlanCache& plans,
+                   std::vector<std::complex<double>>& spectrum, CoefficientStore& out,
+                   int sortCount, ThreadPool* pool,
+                   const std::atomic<std::uint64_t>* latest, std::uint64_t generation) {
+    auto cancelled = [&]() {
+        return latest && latest->load(std::memory_order_relaxed) != generation;
+    };
+
+    int N = path.size();
+    if (pool && (pool->size() < 2 || N < ParallelFFT::MIN_PARALLEL_SIZE)) pool = nullptr;
+
+    // Transform the whole path at once: X[j] = sum x[n] * e^(-i*2π*j*n/N)
+    // Plan and buffer are reused across calls with the same N
+    spectrum.resize(N);
+    forRange(pool, N, [&](int begin, int end) {
+        for (int n = begin; n < end; n++) {
+            spectrum[n] = std::complex<double>(path[n].x, path[n].y);
+        }
+    });
+    if (!pool || !ParallelFFT::forward(spectrum.data(), N, *pool)) {
+        std::shared_ptr<FFTPlan> plan = plans.acquire(N);
+        plan->forward(spectrum.data());
+    }
+    if (cancelled()) return false;
+
+    // Collect coefficients for frequencies from -N/2 to N/2 (negative k wraps to N + k)
+    int count = 2 * (N / 2);
+    std::vector<CoeffData> coeffData(count);
+    forRange(pool, count, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            int k = i - N / 2;
+            std::complex<double> coeff = spectrum[(k + N) % N] / static_cast<double>(N);
+            coeffData[i] = {coeff, k, std::abs(coeff)};
+        }
+    });
+
+    // Sort by magnitude (largest first). In top-K mode, select the K largest in
+    // O(N) and sort only those; the tail is sorted later if more become visible.
+    if (sortCount <= 0 || sortCount > count) sortCount = count;
+    if (pool) {
+        sortLargest(coeffData, sortCount, *pool);
+    } else {
+        sortLargest(coeffData, sortCount);
+    }
+    if (cancelled()) return false;
+
+    // Store coefficients as separate arrays, plus their fixed radius/phase
+    out.resize(count);
+    forRange(pool, count, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            const CoeffData& data = coeffData[i];
+            out.re[i] = data.coeff.real();
+            out.im[i] = data.coeff.imag();
+            out.frequency[i] = data.frequency;
+            out.radius[i] = data.magnitude;
+            out.phase[i] = std::arg(data.coeff);
+        }
+    });
+    out.sortedCount = sortCount;
+    out.updatePrefixMaxFrequency();
+    return true;
 }
 
-void FourierEngine::computeDFT(const std::vector<Point2D>& path) {
-    originalPath = path;
+// Resample path to size points at evenly spaced parameters, interpolating
+// between neighbours so preview time t lines up with the full path
+void decimatePath(const std::vector<Point2D>& path, int size, std::vector<Point2D>& out) {
     int N = path.size();
+    double stride = static_cast<double>(N) / size;
+    out.resize(size);
+    for (int i = 0; i < size; i++) {
+        double position = i * stride;
+        int index = static_cast<int>(position);
+        float frac = static_cast<float>(position - index);
+        const Point2D& a = path[index];
+        const Point2D& b = path[(index + 1) % N];
+        out[i] = Point2D(a.x + (b.x - a.x) * frac, a.y + (b.y - a.y) * frac);
+    }
+}
+
+} // namespace
+
+template <typename Precision>
+BasicFourierEngine<Precision>::BasicFourierEngine()
+    : numEpicycles(0), topK(0),
+      tickRate(DEFAULT_TICK_RATE), accumulator(0.0), clockTime(0.0), tickCount(0),
+      evaluationMode(EvaluationMode::Phasor), phasorTime(0.0), stepSize(0.0),
+      stepCount(0), phasorCount(0), phasorSteps(0), phasorsValid(false),
+      slotGeneration{0, 0, 0}, slotExact{true, true, true},
+      frontSlot(0), backSlot(2), middleSlot(1),
+      latestGeneration(0), coeffsGeneration(0), coeffsExact(true), refined(false),
+      pendingGeneration(0), pendingSortCount(0),
+      hasPending(false), stopWorker(false), computing(false), threadCount(0) {
+}
+
+template <typename Precision>
+BasicFourierEngine<Precision>::~BasicFourierEngine() {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        stopWorker = true;
+        latestGeneration++;  // Cancels a transform in flight
+    }
+    requestReady.notify_one();
+    if (worker.joinable()) worker.join();
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::computeDFT(const std::vector<Point2D>& path) {
+    if (path.empty()) return;
+    computeDFT(std::vector<Point2D>(path));
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::computeDFT(std::vector<Point2D>&& path) {
+    if (path.empty()) return;
+
+    // Newer than anything queued, so stale background results are dropped
+    std::uint64_t generation = ++latestGeneration;
+
+    std::shared_ptr<ThreadPool> threads;
+    std::shared_ptr<CoefficientCache> diskCache;
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        threads = acquirePool(static_cast<int>(path.size()));
+        diskCache = cache;
+    }
+
+    std::uint64_t key = diskCache ? CoefficientCache::hashPath(path.data(), path.size()) : 0;
+    if (!diskCache || !diskCache->load(key, path.size(), coeffs)) {
+        transformPath(path, planCache, spectrum, coeffs, sortCount(), threads.get(), nullptr, generation);
+        if (diskCache) diskCache->save(key, path.size(), coeffs);
+    }
+    originalPath = std::move(path);
+    coeffsGeneration = generation;
+    coeffsExact = true;
+    refined = false;
+    adoptCoefficients();
+    ensureSorted(activeCount());  // A cached set may have been sorted for fewer terms
+}
 
-    if (N == 0) return;
+template <typename Precision>
+void BasicFourierEngine<Precision>::loadPreset(const PresetShape& preset, float scale) {
+    // Supersedes anything queued, like computeDFT
+    std::uint64_t generation = ++latestGeneration;
 
-    coefficients.clear();
-    frequencies.clear();
+    originalPath.resize(preset.pointCount);
+    for (int i = 0; i < preset.pointCount; i++) {
+        originalPath[i] = Point2D(preset.points[i].x * scale, preset.points[i].y * scale);
+    }
+
+    // Scaling the outline scales every coefficient; phases are unchanged
+    int count = preset.coefficientCount;
+    coeffs.resize(count);
+    for (int i = 0; i < count; i++) {
+        coeffs.re[i] = preset.re[i] * scale;
+        coeffs.im[i] = preset.im[i] * scale;
+        coeffs.radius[i] = preset.radius[i] * scale;
+        coeffs.phase[i] = preset.phase[i];
+        coeffs.frequency[i] = preset.frequency[i];
+        coeffs.prefixMaxFrequency[i] = preset.prefixMaxFrequency[i];
+    }
+    coeffs.sortedCount = count;
+
+    coeffsGeneration = generation;
+    coeffsExact = true;
+    refined = false;
+    adoptCoefficients();
+}
 
-    // Compute DFT coefficients for frequencies from -N/2 to N/2
-    std::vector<CoeffData> coeffData;
-    for (int k = -N/2; k < N/2; k++) {
-        std::complex<double> sum(0.0, 0.0);
+template <typename Precision>
+void BasicFourierEngine<Precision>::submitPath(const std::vector<Point2D>& path) {
+    if (path.empty()) return;
+    submitPath(std::vector<Point2D>(path));
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::submitPath(std::vector<Point2D>&& path) {
+    if (path.empty()) return;
 
-        for (int n = 0; n < N; n++) {
-            // Convert point to complex number
-            std::complex<double> point(path[n].x, path[n].y);
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        pendingPath = std::move(path);
+        pendingGeneration = ++latestGeneration;
+        pendingSortCount = sortCount();
+        hasPending = true;
+        computing = true;
+        if (!worker.joinable()) {
+            worker = std::thread(&BasicFourierEngine::workerLoop, this);
+        }
+    }
+    requestReady.notify_one();
+}
 
-            // Calculate e^(-i*2π*k*n/N)
-            double angle = -TWO_PI * k * n / N;
-            std::complex<double> exponential(std::cos(angle), std::sin(angle));
+template <typename Precision>
+void BasicFourierEngine<Precision>::workerLoop() {
+    std::vector<Point2D> path;
+    for (;;) {
+        std::uint64_t generation;
+        int sorted;
+        std::shared_ptr<ThreadPool> threads;
+        std::shared_ptr<CoefficientCache> diskCache;
+        {
+            std::unique_lock<std::mutex> lock(requestMutex);
+            requestReady.wait(lock, [this]() { return hasPending || stopWorker; });
+            if (stopWorker) return;
+            path.swap(pendingPath);
+            generation = pendingGeneration;
+            sorted = pendingSortCount;
+            hasPending = false;
+            threads = acquirePool(static_cast<int>(path.size()));
+            diskCache = cache;
+        }
 
-            // Add to sum
-            sum += point * exponential;
+        // The back slot belongs to this thread until it is exchanged into the middle.
+        // A cached transform is exact straight away, so it skips the previews.
+        int N = path.size();
+        std::uint64_t key = diskCache ? CoefficientCache::hashPath(path.data(), path.size()) : 0;
+        if (diskCache && diskCache->load(key, path.size(), slots[backSlot])) {
+            slotPaths[backSlot].swap(path);
+            publish(generation, true);
+        } else {
+            bool cancelled = false;
+            for (int size = PREVIEW_SIZE; 2 * size <= N && !cancelled; size *= PREVIEW_GROWTH) {
+                decimatePath(path, size, previewPath);
+                cancelled = !transformPath(previewPath, workerPlans, workerSpectrum, slots[backSlot],
+                                           sorted, threads.get(), &latestGeneration, generation);
+                if (!cancelled) publish(generation, false);
+            }
+            if (!cancelled && transformPath(path, workerPlans, workerSpectrum, slots[backSlot],
+                                            sorted, threads.get(), &latestGeneration, generation)) {
+                if (diskCache) diskCache->save(key, path.size(), slots[backSlot]);
+                slotPaths[backSlot].swap(path);
+                publish(generation, true);
+            }
         }
 
-        // Average and store coefficient with frequency
-        std::complex<double> coeff = sum / static_cast<double>(N);
-        coeffData.push_back({coeff, k, std::abs(coeff)});
+        std::lock_guard<std::mutex> lock(requestMutex);
+        if (!hasPending) computing = false;
     }
+}
 
-    // Sort by magnitude (largest first)
-    std::sort(coeffData.begin(), coeffData.end(),
-        [](const CoeffData& a, const CoeffData& b) {
-            return a.magnitude > b.magnitude;
-        });
+template <typename Precision>
+std::shared_ptr<ThreadPool> BasicFourierEngine<Precision>::acquirePool(int n) {
+    if (n < ParallelFFT::MIN_PARALLEL_SIZE || threadCount == 1) return nullptr;
+    if (!pool) pool = std::make_shared<ThreadPool>(threadCount);
+    return pool;
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::publish(std::uint64_t generation, bool exact) {
+    slotGeneration[backSlot] = generation;
+    slotExact[backSlot] = exact;
+    backSlot = middleSlot.exchange(backSlot | PUBLISHED_FLAG,
+                                   std::memory_order_acq_rel) & SLOT_MASK;
+}
+
+template <typename Precision>
+bool BasicFourierEngine<Precision>::acquireLatest() {
+    if (!(middleSlot.load(std::memory_order_acquire) & PUBLISHED_FLAG)) return false;
+    frontSlot = middleSlot.exchange(frontSlot, std::memory_order_acq_rel) & SLOT_MASK;
 
-    // Store sorted coefficients and frequencies
-    for (const auto& data : coeffData) {
-        coefficients.push_back(data.coeff);
-        frequencies.push_back(data.frequency);
+    // Superseded by a newer submission or a blocking computeDFT
+    if (slotGeneration[frontSlot] != latestGeneration.load(std::memory_order_relaxed)) {
+        return false;
     }
+
+    // Swapping stores only exchanges buffer pointers; the old set becomes spare
+    std::swap(coeffs, slots[frontSlot]);
+    if (slotExact[frontSlot]) originalPath.swap(slotPaths[frontSlot]);
+    refined = slotGeneration[frontSlot] == coeffsGeneration;
+    coeffsGeneration = slotGeneration[frontSlot];
+    coeffsExact = slotExact[frontSlot];
+    adoptCoefficients();
+    ensureSorted(activeCount());  // The count may have been raised since submitting
+    return true;
 }
 
-std::vector<Epicycle> FourierEngine::getEpicycles(double t) const {
-    std::vector<Epicycle> epicycles;
+template <typename Precision>
+bool BasicFourierEngine<Precision>::isComputing() const {
+    return computing.load();
+}
 
-    if (coefficients.empty()) return epicycles;
+template <typename Precision>
+bool BasicFourierEngine<Precision>::isExact() const {
+    return coeffsExact;
+}
 
-    // Calculate epicycles for each frequency (already sorted by magnitude)
-    for (int i = 0; i < static_cast<int>(coefficients.size()); i++) {
-        int k = frequencies[i];  // Get stored frequency
+template <typename Precision>
+bool BasicFourierEngine<Precision>::isRefinement() const {
+    return refined;
+}
 
-        // Get the coefficient for this frequency
-        std::complex<double> coeff = coefficients[i];
+template <typename Precision>
+void BasicFourierEngine<Precision>::adoptCoefficients() {
+    // New coefficient set: buffers are sized for every count up front, and
+    // phasors must be evaluated directly on next use
+    int count = static_cast<int>(coeffs.size());
+    phasorRe.resize(count);
+    phasorIm.resize(count);
+    stepRe.resize(count);
+    stepIm.resize(count);
+    centerX.resize(count);
+    centerY.resize(count);
+    stepPowers.resize(count > 0 ? coeffs.prefixMaxFrequency[count - 1] + 1 : 1);
+    convertTerms(0);
+    stepCount = 0;
+    phasorCount = 0;
+    phasorsValid = false;
+}
 
-        // Calculate rotation: coeff * e^(i*2π*k*t)
-        double angle = TWO_PI * k * t;
-        std::complex<double> rotation(std::cos(angle), std::sin(angle));
-        std::complex<double> rotated = coeff * rotation;
+template <typename Precision>
+void BasicFourierEngine<Precision>::convertTerms(int begin) {
+    // Double evaluation reads coeffs directly
+    if constexpr (!std::is_same<Real, double>::value) {
+        int count = static_cast<int>(coeffs.size());
+        termRe.resize(count);
+        termIm.resize(count);
+        for (int i = begin; i < count; i++) {
+            termRe[i] = static_cast<Real>(coeffs.re[i]);
+            termIm[i] = static_cast<Real>(coeffs.im[i]);
+        }
+    }
+}
 
-        // Create epicycle
-        Epicycle epic;
-        epic.radius = std::abs(coeff);  // Magnitude
-        epic.frequency = k;
-        epic.phase = std::arg(coeff);   // Phase
-        epic.center = Point2D(rotated.real(), rotated.imag());
-        epic.color = sf::Color::White;  // Will be set later
+template <typename Precision>
+const typename BasicFourierEngine<Precision>::Real* BasicFourierEngine<Precision>::termsRe() const {
+    if constexpr (std::is_same<Real, double>::value) {
+        return coeffs.re.data();
+    } else {
+        return termRe.data();
+    }
+}
 
-        epicycles.push_back(epic);
+template <typename Precision>
+const typename BasicFourierEngine<Precision>::Real* BasicFourierEngine<Precision>::termsIm() const {
+    if constexpr (std::is_same<Real, double>::value) {
+        return coeffs.im.data();
+    } else {
+        return termIm.data();
     }
+}
 
+template <typename Precision>
+std::vector<Epicycle> BasicFourierEngine<Precision>::getEpicycles(double t, Point2D origin) const {
+    std::vector<Epicycle> epicycles(activeCount());
+    Point2D tip;
+    int count = getEpicycles(t, origin, epicycles.data(), static_cast<int>(epicycles.size()), tip);
+    epicycles.resize(count);
     return epicycles;
 }
 
-Point2D FourierEngine::getTracedPoint(double t) const {
-    // The traced point is the sum of all rotated coefficients
-    std::complex<double> sum(0.0, 0.0);
+template <typename Precision>
+int BasicFourierEngine<Precision>::getEpicycles(double t, Point2D origin, Epicycle* out, int capacity, Point2D& tip) const {
+    tip = origin;
+    if (coeffs.empty()) return 0;
+
+    syncPhasors(t);
+
+    // Rotate each active coefficient (coeff * e^(i*2π*k*t)) and chain them in one SIMD pass
+    int count = activeCount();
+    Real tipX, tipY;
+    EpicycleKernel::chain(termsRe(), termsIm(),
+                          phasorRe.data(), phasorIm.data(), count,
+                          origin.x, origin.y, centerX.data(), centerY.data(), tipX, tipY);
+    tip = Point2D(tipX, tipY);
+
+    // Epicycles are already sorted by magnitude
+    int written = std::min(count, capacity);
+    for (int i = 0; i < written; i++) {
+        Epicycle& epic = out[i];
+        epic.radius = coeffs.radius[i];
+        epic.frequency = coeffs.frequency[i];
+        epic.phase = coeffs.phase[i];
+        epic.center = Point2D(centerX[i], centerY[i]);
+    }
+
+    return written;
+}
+
+template <typename Precision>
+Point2D BasicFourierEngine<Precision>::getTracedPoint(double t) const {
+    // The traced point is the sum of the active rotated coefficients
+    if (coeffs.empty()) return Point2D(0.0, 0.0);
+
+    syncPhasors(t);
+
+    Real x, y;
+    EpicycleKernel::sum(termsRe(), termsIm(),
+                        phasorRe.data(), phasorIm.data(), activeCount(), x, y);
+    return Point2D(x, y);
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::sampleCurve(Point2D* out, int numSamples, int numTerms, double startTime) const {
+    if (numSamples <= 0) return;
+
+    int count = static_cast<int>(coeffs.size());
+    if (numTerms < 0) numTerms = activeCount();
+    if (numTerms > count) numTerms = count;
+
+    // Sampling M points folds frequency k onto bin k mod M exactly, so every
+    // term lands in one bin and a single inverse FFT gives all the samples
+    sampleBuffer.assign(numSamples, std::complex<double>(0.0, 0.0));
+    for (int i = 0; i < numTerms; i++) {
+        int k = coeffs.frequency[i];
+        std::complex<double> coeff(coeffs.re[i], coeffs.im[i]);
+        if (startTime != 0.0) {
+            double angle = TWO_PI * k * startTime;
+            coeff *= std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+
+        int bin = k % numSamples;
+        if (bin < 0) bin += numSamples;
+        sampleBuffer[bin] += coeff;
+    }
+
+    planCache.acquire(numSamples)->inverse(sampleBuffer.data());
+
+    for (int m = 0; m < numSamples; m++) {
+        out[m] = Point2D(sampleBuffer[m].real(), sampleBuffer[m].imag());
+    }
+}
+
+template <typename Precision>
+int BasicFourierEngine<Precision>::activeCount() const {
+    int count = static_cast<int>(coeffs.size());
+    return (numEpicycles > 0 && numEpicycles < count) ? numEpicycles : count;
+}
+
+template <typename Precision>
+int BasicFourierEngine<Precision>::sortCount() const {
+    if (topK <= 0 || numEpicycles <= 0) return 0;
+    return std::max(topK, numEpicycles);
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::ensureSorted(int count) {
+    int size = static_cast<int>(coeffs.size());
+    int sorted = static_cast<int>(coeffs.sortedCount);
+    count = std::min(count, size);
+    if (count <= sorted) return;
+
+    // Grow the sorted prefix geometrically so stepping the count up is amortized
+    int target = std::min(size, std::max(count, 2 * sorted));
+
+    // Select and sort the next entries of the tail by index, then permute the arrays
+    std::vector<int> order(size - sorted);
+    for (int i = 0; i < size - sorted; i++) order[i] = sorted + i;
+    auto larger = [this](int a, int b) { return coeffs.radius[a] > coeffs.radius[b]; };
+    std::vector<int>::iterator middle = order.begin() + (target - sorted);
+    if (middle != order.end()) std::nth_element(order.begin(), middle, order.end(), larger);
+    std::sort(order.begin(), middle, larger);
+
+    CoefficientStore tail;
+    tail.resize(order.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        int j = order[i];
+        tail.re[i] = coeffs.re[j];
+        tail.im[i] = coeffs.im[j];
+        tail.frequency[i] = coeffs.frequency[j];
+        tail.radius[i] = coeffs.radius[j];
+        tail.phase[i] = coeffs.phase[j];
+    }
+    std::copy(tail.re.begin(), tail.re.end(), coeffs.re.begin() + sorted);
+    std::copy(tail.im.begin(), tail.im.end(), coeffs.im.begin() + sorted);
+    std::copy(tail.frequency.begin(), tail.frequency.end(), coeffs.frequency.begin() + sorted);
+    std::copy(tail.radius.begin(), tail.radius.end(), coeffs.radius.begin() + sorted);
+    std::copy(tail.phase.begin(), tail.phase.end(), coeffs.phase.begin() + sorted);
+    coeffs.sortedCount = target;
+    coeffs.updatePrefixMaxFrequency(sorted);
+    convertTerms(sorted);
+
+    // Cached phasors and steps past the old prefix now belong to other terms
+    phasorCount = std::min(phasorCount, sorted);
+    stepCount = std::min(stepCount, sorted);
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::syncPhasors(double t) const {
+    int active = activeCount();
+    double dt = t - phasorTime;
+    if (phasorsValid && dt == 0.0 && phasorCount >= active) return;
+
+    // Direct mode, resets, rewinds, big skips and the periodic resync use cos/sin
+    if (evaluationMode == EvaluationMode::Direct || !phasorsValid ||
+        dt < 0.0 || dt > MAX_PHASOR_STEP || phasorSteps >= Precision::RESYNC_INTERVAL) {
+        evaluatePhasors(t, 0, active);
+        phasorTime = t;
+        phasorCount = active;
+        phasorSteps = 0;
+        phasorsValid = true;
+        return;
+    }
+
+    if (dt != 0.0) {
+        // Phasors dropped by a lower count go stale and are re-evaluated if needed again
+        int advanced = std::min(phasorCount, active);
+
+        // Per-coefficient step e^(i*2π*k*dt), rebuilt only when the step size changes
+        // or more terms become active. The power table comes from one cos/sin pair by
+        // recurrence and only reaches the largest visible |k|.
+        if (dt != stepSize || stepCount < advanced) {
+            if (dt != stepSize) stepCount = 0;
+            int maxFrequency = advanced > 0 ? coeffs.prefixMaxFrequency[advanced - 1] : 0;
+            std::complex<double> base(std::cos(TWO_PI * dt), std::sin(TWO_PI * dt));
+            stepPowers[0] = std::complex<double>(1.0, 0.0);
+            for (int k = 1; k <= maxFrequency; k++) {
+                stepPowers[k] = stepPowers[k - 1] * base;
+            }
+            for (int i = stepCount; i < advanced; i++) {
+                int k = coeffs.frequency[i];
+                const std::complex<double>& step = stepPowers[std::abs(k)];
+                stepRe[i] = static_cast<Real>(step.real());
+                stepIm[i] = static_cast<Real>(k >= 0 ? step.imag() : -step.imag());  // Negative k: conjugate
+            }
+            stepSize = dt;
+            stepCount = std::max(stepCount, advanced);
+        }
+
+        EpicycleKernel::advance(phasorRe.data(), phasorIm.data(), stepRe.data(), stepIm.data(), advanced);
+        phasorSteps++;
+
+        // One Newton step toward |z| = 1 keeps rounding from growing the circles
+        if (phasorSteps % Precision::RENORMALIZE_INTERVAL == 0) {
+            EpicycleKernel::renormalize(phasorRe.data(), phasorIm.data(), advanced);
+        }
+
+        phasorTime = t;
+        phasorCount = advanced;
+    }
 
-    if (coefficients.empty()) return Point2D(0.0, 0.0);
+    // Terms that just became active start from a direct evaluation
+    if (phasorCount < active) {
+        evaluatePhasors(t, phasorCount, active);
+        phasorCount = active;
+    }
+}
 
-    for (int i = 0; i < static_cast<int>(coefficients.size()); i++) {
-        int k = frequencies[i];  // Get stored frequency
-        double angle = TWO_PI * k * t;
-        std::complex<double> rotation(std::cos(angle), std::sin(angle));
-        sum += coefficients[i] * rotation;
+template <typename Precision>
+void BasicFourierEngine<Precision>::evaluatePhasors(double t, int begin, int end) const {
+    for (int i = begin; i < end; i++) {
+        double angle = TWO_PI * coeffs.frequency[i] * t;
+        phasorRe[i] = static_cast<Real>(std::cos(angle));
+        phasorIm[i] = static_cast<Real>(std::sin(angle));
     }
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::setTickRate(double ticksPerSecond) {
+    if (ticksPerSecond <= 0.0) return;
+    accumulator *= ticksPerSecond / tickRate;
+    tickRate = ticksPerSecond;
+}
+
+template <typename Precision>
+double BasicFourierEngine<Precision>::getTickRate() const {
+    return tickRate;
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::accumulate(double seconds) {
+    if (seconds > 0.0) accumulator += seconds * tickRate;
+}
+
+template <typename Precision>
+bool BasicFourierEngine<Precision>::step(double speed) {
+    if (accumulator + TICK_EPSILON < 1.0) return false;
+    accumulator = std::max(accumulator - 1.0, 0.0);
+    clockTime += speed / tickRate;
+    tickCount++;
+    return true;
+}
+
+template <typename Precision>
+double BasicFourierEngine<Precision>::getTime() const {
+    return clockTime;
+}
+
+template <typename Precision>
+double BasicFourierEngine<Precision>::getInterpolation() const {
+    return std::min(accumulator, 1.0);
+}
 
-    return Point2D(sum.real(), sum.imag());
+template <typename Precision>
+std::uint64_t BasicFourierEngine<Precision>::getTickCount() const {
+    return tickCount;
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::resetClock() {
+    accumulator = 0.0;
+    clockTime = 0.0;
+    tickCount = 0;
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::evaluateTick(Point2D origin, EpicycleTicks& ticks) const {
+    int capacity = static_cast<int>(ticks.epicycles[0].size());
+    ticks.latest ^= 1;
+    int slot = ticks.latest;
+    ticks.counts[slot] = getEpicycles(clockTime, origin, ticks.epicycles[slot].data(), capacity, ticks.tips[slot]);
+    if (ticks.stale) {
+        // Nothing earlier to blend from: both ticks are this one
+        std::copy(ticks.epicycles[slot].begin(), ticks.epicycles[slot].begin() + ticks.counts[slot],
+                  ticks.epicycles[slot ^ 1].begin());
+        ticks.counts[slot ^ 1] = ticks.counts[slot];
+        ticks.tips[slot ^ 1] = ticks.tips[slot];
+        ticks.stale = false;
+    }
 }
 
-void FourierEngine::update(double dt, double speed) {
-    time += dt * speed;
+template <typename Precision>
+Point2D BasicFourierEngine<Precision>::interpolateTicks(const EpicycleTicks& ticks, Epicycle* out, int& count) const {
+    const Epicycle* to = ticks.epicycles[ticks.latest].data();
+    const Epicycle* from = ticks.epicycles[ticks.latest ^ 1].data();
+    count = ticks.counts[ticks.latest];
+    float alpha = static_cast<float>(getInterpolation());
+    bool blend = ticks.counts[ticks.latest ^ 1] == count;
+
+    // Centers move along the chord between ticks; less than a tick of rotation
+    for (int i = 0; i < count; i++) {
+        out[i] = to[i];
+        if (blend) {
+            out[i].center = Point2D(from[i].center.x + (to[i].center.x - from[i].center.x) * alpha,
+                                    from[i].center.y + (to[i].center.y - from[i].center.y) * alpha);
+        }
+    }
+    const Point2D& a = ticks.tips[ticks.latest ^ 1];
+    const Point2D& b = ticks.tips[ticks.latest];
+    if (!blend) return b;
+    return Point2D(a.x + (b.x - a.x) * alpha, a.y + (b.y - a.y) * alpha);
 }
 
-void FourierEngine::setNumEpicycles(int n) {
+template <typename Precision>
+void BasicFourierEngine<Precision>::setNumEpicycles(int n) {
     numEpicycles = n;
+    ensureSorted(activeCount());
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::setTopK(int k) {
+    topK = k;
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::setThreadCount(int threads) {
+    // A transform still using the old pool keeps it alive until it finishes
+    std::lock_guard<std::mutex> lock(requestMutex);
+    threadCount = std::max(0, threads);
+    pool.reset();
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::setCache(std::shared_ptr<CoefficientCache> diskCache) {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    cache = std::move(diskCache);
+}
+
+template <typename Precision>
+void BasicFourierEngine<Precision>::setEvaluationMode(EvaluationMode mode) {
+    evaluationMode = mode;
+    phasorsValid = false;
+}
+
+template <typename Precision>
+int BasicFourierEngine<Precision>::getActiveEpicycles() const {
+    return activeCount();
+}
+
+template <typename Precision>
+const CoefficientStore& BasicFourierEngine<Precision>::getCoefficients() const {
+    return coeffs;
 }
+
+template <typename Precision>
+FFTPlanCache& BasicFourierEngine<Precision>::getPlanCache() {
+    return planCache;
+}
+
+template <typename Precision>
+const FFTPlanCache& BasicFourierEngine<Precision>::getPlanCache() const {
+    return planCache;
+}
+
+template class BasicFourierEngine<SinglePrecision>;
+template class BasicFourierEngine<DoublePrecision>;
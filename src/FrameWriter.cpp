@@ -0,0 +1,74 @@
+#include "FrameWriter.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+FrameWriter::FrameWriter(const std::string& directory, std::size_t maxQueuedFrames)
+    : directory(directory), maxQueued(maxQueuedFrames > 0 ? maxQueuedFrames : 1), nextIndex(0),
+      stopping(false), framesWritten(0), failures(0) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Failed to create output directory " << directory << ": " << error.message() << std::endl;
+    }
+    worker = std::thread(&FrameWriter::run, this);
+}
+
+FrameWriter::~FrameWriter() {
+    finish();
+}
+
+void FrameWriter::submit(sf::Image image) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueChanged.wait(lock, [this] { return queue.size() < maxQueued || stopping; });
+    if (stopping) return;
+
+    queue.emplace_back(nextIndex++, std::move(image));
+    queueChanged.notify_all();
+}
+
+void FrameWriter::finish() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void FrameWriter::run() {
+    char name[32];
+    for (;;) {
+        std::pair<int, sf::Image> frame;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this] { return !queue.empty() || stopping; });
+            if (queue.empty()) return;  // Stopping and fully drained
+
+            frame = std::move(queue.front());
+            queue.pop_front();
+        }
+        queueChanged.notify_all();
+
+        // PNG encoding happens outside the lock, in parallel with rendering
+        std::snprintf(name, sizeof(name), "frame_%05d.png", frame.first);
+        if (frame.second.saveToFile(std::filesystem::path(directory) / name)) {
+            framesWritten++;
+        } else {
+            failures++;
+            std::cerr << "Failed to write " << name << std::endl;
+        }
+    }
+}
+
+int FrameWriter::getFramesWritten() const {
+    return framesWritten.load();
+}
+
+int FrameWriter::getFailures() const {
+    return failures.load();
+}
+
+const std::string& FrameWriter::getDirectory() const {
+    return directory;
+}
@@ -8,7 +8,9 @@ void InputHandler::handleEvent(const sf::Event& event, const sf::RenderWindow& w
     if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
         if (mousePressed->button == sf::Mouse::Button::Left) {
             drawing = true;
-            drawnPath.clear();
+            drawnPath.reset();
+            drawnPath.addPoint(Point2D(static_cast<float>(mousePressed->position.x),
+                                       static_cast<float>(mousePressed->position.y)));
         }
     }
 
@@ -16,6 +18,7 @@ void InputHandler::handleEvent(const sf::Event& event, const sf::RenderWindow& w
     if (const auto* mouseReleased = event.getIf<sf::Event::MouseButtonReleased>()) {
         if (mouseReleased->button == sf::Mouse::Button::Left) {
             drawing = false;
+            drawnPath.finish();
         }
     }
 
@@ -26,7 +29,7 @@ void InputHandler::handleEvent(const sf::Event& event, const sf::RenderWindow& w
                 static_cast<float>(mouseMoved->position.x),
                 static_cast<float>(mouseMoved->position.y)
             );
-            drawnPath.push_back(point);
+            drawnPath.addPoint(point);
         }
     }
 }
@@ -36,9 +39,9 @@ bool InputHandler::isDrawing() const {
 }
 
 const std::vector<Point2D>& InputHandler::getDrawnPath() const {
-    return drawnPath;
+    return drawnPath.getPoints();
 }
 
 void InputHandler::clearPath() {
-    drawnPath.clear();
+    drawnPath.reset();
 }
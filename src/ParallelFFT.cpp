@@ -0,0 +1,80 @@
+#include "ParallelFFT.h"
+#include "FFTPlan.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const double TWO_PI = 2.0 * M_PI;
+
+// Twiddles come from a recurrence, re-evaluated directly this often to bound drift
+const int TWIDDLE_RESYNC_INTERVAL = 64;
+
+// Columns shorter than this make the split too lopsided to pay off
+const int MIN_SPLIT = 16;
+
+// Largest divisor of n not above sqrt(n)
+int balancedFactor(int n) {
+    int best = 1;
+    for (int d = 2; static_cast<long long>(d) * d <= n; d++) {
+        if (n % d == 0) best = d;
+    }
+    return best;
+}
+
+} // namespace
+
+namespace ParallelFFT {
+
+bool forward(std::complex<double>* data, int n, ThreadPool& pool) {
+    using Complex = std::complex<double>;
+
+    if (n < MIN_PARALLEL_SIZE || pool.size() < 2) return false;
+    int n1 = balancedFactor(n);
+    if (n1 < MIN_SPLIT) return false;
+    int n2 = n / n1;
+
+    // Index maps: input n = n2Len*i1 + i2, output k = k1 + n1*k2
+    std::vector<Complex> scratch(n);
+    int grain = std::max(1, n2 / (4 * pool.size()));
+
+    // Step 1 and 2: FFT each column i2 (length n1), then scale by W_N^(i2*k1).
+    // Columns are stored contiguously in scratch as [i2][k1].
+    pool.parallelFor(n2, grain, [&](int begin, int end) {
+        FFTPlan plan(n1);  // Plans own scratch, so each chunk builds its own
+        for (int i2 = begin; i2 < end; i2++) {
+            Complex* column = scratch.data() + static_cast<std::size_t>(i2) * n1;
+            for (int i1 = 0; i1 < n1; i1++) column[i1] = data[static_cast<std::size_t>(n2) * i1 + i2];
+            plan.forward(column);
+
+            double angle = -TWO_PI * i2 / n;
+            Complex step(std::cos(angle), std::sin(angle));
+            Complex twiddle(1.0, 0.0);
+            for (int k1 = 0; k1 < n1; k1++) {
+                if (k1 % TWIDDLE_RESYNC_INTERVAL == 0) {
+                    double exact = -TWO_PI * ((static_cast<long long>(i2) * k1) % n) / n;
+                    twiddle = Complex(std::cos(exact), std::sin(exact));
+                }
+                column[k1] *= twiddle;
+                twiddle *= step;
+            }
+        }
+    });
+
+    // Step 3: FFT each row k1 (length n2) and scatter to X[k1 + n1*k2]
+    grain = std::max(1, n1 / (4 * pool.size()));
+    pool.parallelFor(n1, grain, [&](int begin, int end) {
+        FFTPlan plan(n2);
+        std::vector<Complex> row(n2);
+        for (int k1 = begin; k1 < end; k1++) {
+            for (int i2 = 0; i2 < n2; i2++) row[i2] = scratch[static_cast<std::size_t>(i2) * n1 + k1];
+            plan.forward(row.data());
+            for (int k2 = 0; k2 < n2; k2++) data[k1 + static_cast<std::size_t>(n1) * k2] = row[k2];
+        }
+    });
+
+    return true;
+}
+
+} // namespace ParallelFFT
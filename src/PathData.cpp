@@ -1,5 +1,68 @@
 #include "PathData.h"
+#include "FFTPlan.h"
+#include <algorithm>
 #include <cmath>
+#include <utility>
+
+namespace {
+
+// Distance from p to the segment a-b
+double distanceToSegment(Point2D p, Point2D a, Point2D b) {
+    double dx = static_cast<double>(b.x) - a.x;
+    double dy = static_cast<double>(b.y) - a.y;
+    double px = static_cast<double>(p.x) - a.x;
+    double py = static_cast<double>(p.y) - a.y;
+    double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? std::clamp((px * dx + py * dy) / lengthSquared, 0.0, 1.0) : 0.0;
+    return std::hypot(px - t * dx, py - t * dy);
+}
+
+// Arc length up to each point, accumulated in double so long paths don't drift
+std::vector<double> cumulativeLengths(const Point2D* path, std::size_t count) {
+    std::vector<double> cumulative(count, 0.0);
+    for (std::size_t i = 1; i < count; i++) {
+        double dx = static_cast<double>(path[i].x) - path[i - 1].x;
+        double dy = static_cast<double>(path[i].y) - path[i - 1].y;
+        cumulative[i] = cumulative[i - 1] + std::sqrt(dx * dx + dy * dy);
+    }
+    return cumulative;
+}
+
+// Largest distance of any vertex from the chord between the arc-length samples
+// around it, when path is resampled to samples points
+double resampleError(const std::vector<Point2D>& path, const std::vector<double>& cumulative, int samples) {
+    double step = cumulative.back() / (samples - 1);
+    if (step <= 0.0) return 0.0;
+
+    // Point at arc length s, found by sweeping forward from segment
+    std::size_t segment = 1;
+    auto pointAt = [&](double s) {
+        while (segment < path.size() - 1 && cumulative[segment] < s) segment++;
+        double length = cumulative[segment] - cumulative[segment - 1];
+        double t = length > 0.0 ? std::min(1.0, (s - cumulative[segment - 1]) / length) : 0.0;
+        const Point2D& a = path[segment - 1];
+        const Point2D& b = path[segment];
+        return Point2D(static_cast<float>(a.x + t * (static_cast<double>(b.x) - a.x)),
+                       static_cast<float>(a.y + t * (static_cast<double>(b.y) - a.y)));
+    };
+
+    // Vertices and sample positions both increase, so the chord moves forward only
+    double error = 0.0;
+    int chord = -1;
+    Point2D chordStart, chordEnd;
+    for (std::size_t i = 1; i + 1 < path.size(); i++) {
+        int k = std::min(static_cast<int>(cumulative[i] / step), samples - 2);
+        if (k != chord) {
+            chordStart = pointAt(k * step);
+            chordEnd = pointAt((k + 1) * step);
+            chord = k;
+        }
+        error = std::max(error, distanceToSegment(path[i], chordStart, chordEnd));
+    }
+    return error;
+}
+
+} // namespace
 
 std::vector<Point2D> PathData::createCircle(int numPoints, float radius) {
     std::vector<Point2D> points;
@@ -126,51 +189,151 @@ std::vector<Point2D> PathData::createInfinity(int numPoints, float scale) {
 
 std::vector<Point2D> PathData::resamplePath(const std::vector<Point2D>& path, int targetPoints) {
     if (path.size() < 2) return path;
+    return resamplePath(path.data(), path.size(), targetPoints);
+}
+
+std::vector<Point2D> PathData::resamplePath(const Point2D* path, std::size_t count, int targetPoints) {
+    if (count < 2) return std::vector<Point2D>(path, path + count);
+    if (targetPoints < 2) return std::vector<Point2D>(path, path + std::min<std::size_t>(count, std::max(targetPoints, 0)));
 
-    // Calculate total path length
-    float totalLength = 0.0f;
-    for (size_t i = 1; i < path.size(); i++) {
-        float dx = path[i].x - path[i-1].x;
-        float dy = path[i].y - path[i-1].y;
-        totalLength += std::sqrt(dx * dx + dy * dy);
+    std::vector<double> cumulative = cumulativeLengths(path, count);
+
+    // Targets increase, so one sweep over the segments places every output point
+    std::vector<Point2D> resampled(targetPoints);
+    double step = cumulative[count - 1] / (targetPoints - 1);
+    std::size_t segment = 1;  // Current segment runs from point segment - 1 to segment
+    resampled[0] = path[0];
+    for (int i = 1; i < targetPoints - 1; i++) {
+        double target = i * step;
+        while (segment < count - 1 && cumulative[segment] < target) segment++;
+
+        double segmentLength = cumulative[segment] - cumulative[segment - 1];
+        double t = segmentLength > 0.0 ? (target - cumulative[segment - 1]) / segmentLength : 0.0;
+        const Point2D& a = path[segment - 1];
+        const Point2D& b = path[segment];
+        resampled[i] = Point2D(static_cast<float>(a.x + t * (static_cast<double>(b.x) - a.x)),
+                               static_cast<float>(a.y + t * (static_cast<double>(b.y) - a.y)));
     }
+    resampled[targetPoints - 1] = path[count - 1];
+    return resampled;
+}
 
-    // Resample at even intervals
-    std::vector<Point2D> resampled;
-    float targetDistance = totalLength / (targetPoints - 1);
+StreamingResampler::StreamingResampler(double spacing, std::size_t capacity)
+    : initialSpacing(spacing), spacing(spacing), untilNext(0.0), length(0.0),
+      capacity(std::max<std::size_t>(capacity, 4)), finished(false) {
+    points.reserve(this->capacity + 1);
+}
 
-    resampled.push_back(path[0]);
+void StreamingResampler::reset() {
+    points.clear();
+    spacing = initialSpacing;
+    untilNext = 0.0;
+    length = 0.0;
+    finished = false;
+}
 
-    float accumulatedDist = 0.0f;
-    size_t currentIdx = 0;
+void StreamingResampler::addPoint(Point2D point) {
+    if (finished) {
+        // Drop the unevenly spaced end point; the stroke continues from it
+        points.pop_back();
+        finished = false;
+    }
+    if (points.empty()) {
+        points.push_back(point);
+        last = point;
+        untilNext = spacing;
+        return;
+    }
 
-    for (int i = 1; i < targetPoints - 1; i++) {
-        float targetDist = i * targetDistance;
-
-        // Find the segment containing this target distance
-        while (currentIdx < path.size() - 1) {
-            float dx = path[currentIdx + 1].x - path[currentIdx].x;
-            float dy = path[currentIdx + 1].y - path[currentIdx].y;
-            float segmentLength = std::sqrt(dx * dx + dy * dy);
-
-            if (accumulatedDist + segmentLength >= targetDist) {
-                // Interpolate within this segment
-                float t = (targetDist - accumulatedDist) / segmentLength;
-                Point2D interpolated(
-                    path[currentIdx].x + t * dx,
-                    path[currentIdx].y + t * dy
-                );
-                resampled.push_back(interpolated);
-                break;
-            }
+    double dx = static_cast<double>(point.x) - last.x;
+    double dy = static_cast<double>(point.y) - last.y;
+    double segmentLength = std::sqrt(dx * dx + dy * dy);
+    if (segmentLength == 0.0) return;
+
+    // Emit a sample every spacing units of arc length along the new segment
+    double position = untilNext;
+    while (position <= segmentLength) {
+        double t = position / segmentLength;
+        points.push_back(Point2D(static_cast<float>(last.x + t * dx), static_cast<float>(last.y + t * dy)));
+        position += spacing;
+        if (points.size() > capacity) {
+            position -= thin();
+        }
+    }
+    untilNext = position - segmentLength;
+    length += segmentLength;
+    last = point;
+}
 
-            accumulatedDist += segmentLength;
-            currentIdx++;
+double StreamingResampler::thin() {
+    // Keep every other sample and double the spacing. Returns how much closer
+    // the next sample moved, in arc length.
+    std::size_t count = points.size();
+    for (std::size_t i = 1; 2 * i < count; i++) points[i] = points[2 * i];
+    points.resize((count + 1) / 2);
+    double shift = (count % 2 == 0) ? 0.0 : -spacing;
+    spacing *= 2.0;
+    return shift;
+}
+
+void StreamingResampler::finish() {
+    // Close the stroke at the last raw point, which is usually between samples
+    if (points.empty() || finished) return;
+    const Point2D& end = points.back();
+    if (end.x != last.x || end.y != last.y) {
+        points.push_back(last);
+        finished = true;
+    }
+}
+
+std::vector<Point2D> PathData::simplifyPath(const std::vector<Point2D>& path, float tolerance) {
+    if (path.size() < 3) return path;
+
+    // Split ranges at their farthest point until every range is within tolerance.
+    // An explicit stack keeps long strokes from recursing deeply.
+    std::vector<char> keep(path.size(), 0);
+    keep.front() = keep.back() = 1;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    ranges.push_back({0, path.size() - 1});
+    while (!ranges.empty()) {
+        std::size_t first = ranges.back().first;
+        std::size_t last = ranges.back().second;
+        ranges.pop_back();
+
+        double farthest = 0.0;
+        std::size_t split = first;
+        for (std::size_t i = first + 1; i < last; i++) {
+            double distance = distanceToSegment(path[i], path[first], path[last]);
+            if (distance > farthest) {
+                farthest = distance;
+                split = i;
+            }
+        }
+        if (farthest > tolerance) {
+            keep[split] = 1;
+            ranges.push_back({first, split});
+            ranges.push_back({split, last});
         }
     }
 
-    resampled.push_back(path[path.size() - 1]);
-    return resampled;
+    std::vector<Point2D> simplified;
+    for (std::size_t i = 0; i < path.size(); i++) {
+        if (keep[i]) simplified.push_back(path[i]);
+    }
+    return simplified;
+}
+
+int PathData::chooseSampleCount(const std::vector<Point2D>& path, float tolerance,
+                                int minPoints, int maxPoints) {
+    int lowest = FFTPlan::fastSize(std::max(minPoints, 2));
+    if (path.size() < 3 || lowest >= maxPoints) return std::min(lowest, std::max(maxPoints, 2));
+
+    // Error shrinks with the sample spacing, though not strictly, so scan upward
+    std::vector<double> cumulative = cumulativeLengths(path.data(), path.size());
+    for (int n = lowest; n < maxPoints; n = FFTPlan::fastSize(n + 1)) {
+        if (resampleError(path, cumulative, n) <= tolerance) return n;
+    }
+    return maxPoints;
 }
 
 std::vector<Point2D> PathData::centerPath(const std::vector<Point2D>& path, Point2D center) {
@@ -195,3 +358,52 @@ std::vector<Point2D> PathData::centerPath(const std::vector<Point2D>& path, Poin
 
     return centered;
 }
+
+std::vector<Point2D> PathData::fitPath(const std::vector<Point2D>& path, float size) {
+    if (path.empty()) return path;
+
+    // Bounding box
+    float minX = path[0].x, maxX = path[0].x;
+    float minY = path[0].y, maxY = path[0].y;
+    for (const auto& p : path) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    float extent = std::max(maxX - minX, maxY - minY);
+    if (extent <= 0.0f) return path;
+
+    float scale = size / extent;
+    std::vector<Point2D> fitted;
+    fitted.reserve(path.size());
+    for (const auto& p : path) {
+        fitted.push_back(Point2D(p.x * scale, p.y * scale));
+    }
+    return fitted;
+}
+
+void PathData::centerAndFitPath(std::vector<Point2D>& path, float size) {
+    if (path.empty()) return;
+
+    // Centroid and bounding box together; the extent doesn't depend on the centering
+    double sumX = 0.0, sumY = 0.0;
+    float minX = path[0].x, maxX = path[0].x;
+    float minY = path[0].y, maxY = path[0].y;
+    for (const auto& p : path) {
+        sumX += p.x;
+        sumY += p.y;
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    float centerX = static_cast<float>(sumX / path.size());
+    float centerY = static_cast<float>(sumY / path.size());
+    float extent = std::max(maxX - minX, maxY - minY);
+    float scale = extent > 0.0f ? size / extent : 1.0f;
+
+    for (auto& p : path) {
+        p = Point2D((p.x - centerX) * scale, (p.y - centerY) * scale);
+    }
+}
@@ -0,0 +1,639 @@
+#include "PathLoader.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char BINARY_MAGIC[4] = {'F', 'P', 'T', 'S'};
+const std::uint32_t BINARY_VERSION = 1;
+const std::size_t BINARY_HEADER_SIZE = 16;
+
+// Curves are split at most this deep (4096 segments) however tight the tolerance
+const int MAX_FLATTEN_DEPTH = 12;
+
+// How much of a file to look at when guessing its format
+const std::size_t SNIFF_BYTES = 4096;
+
+static_assert(sizeof(Point2D) == 2 * sizeof(float),
+              "Point2D must be two packed floats to read binary files in place");
+
+bool isLittleEndian() {
+    const std::uint16_t probe = 1;
+    unsigned char firstByte;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+void swapBytes(void* value, std::size_t size) {
+    unsigned char* bytes = static_cast<unsigned char*>(value);
+    std::reverse(bytes, bytes + size);
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// [sign] digits [. digits] [e [sign] digits], bounded by end: the text is usually
+// a file mapping, which is not null-terminated
+bool readNumber(const char*& p, const char* end, double& value) {
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-')) {
+        negative = *s == '-';
+        s++;
+    }
+
+    double mantissa = 0.0;
+    int digits = 0;
+    int exponent = 0;
+    while (s < end && isDigit(*s)) {
+        mantissa = mantissa * 10.0 + (*s - '0');
+        digits++;
+        s++;
+    }
+    if (s < end && *s == '.') {
+        s++;
+        while (s < end && isDigit(*s)) {
+            mantissa = mantissa * 10.0 + (*s - '0');
+            exponent--;
+            digits++;
+            s++;
+        }
+    }
+    if (digits == 0) return false;
+
+    // An 'e' only belongs to the number if digits follow it
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        const char* e = s + 1;
+        bool exponentNegative = false;
+        if (e < end && (*e == '+' || *e == '-')) {
+            exponentNegative = *e == '-';
+            e++;
+        }
+        if (e < end && isDigit(*e)) {
+            int written = 0;
+            while (e < end && isDigit(*e)) {
+                if (written < 10000) written = written * 10 + (*e - '0');
+                e++;
+            }
+            exponent += exponentNegative ? -written : written;
+            s = e;
+        }
+    }
+
+    value = exponent != 0 ? mantissa * std::pow(10.0, exponent) : mantissa;
+    if (negative) value = -value;
+    p = s;
+    return true;
+}
+
+struct Vec2 {
+    double x, y;
+};
+
+Vec2 operator+(Vec2 a, Vec2 b) { return {a.x + b.x, a.y + b.y}; }
+Vec2 operator-(Vec2 a, Vec2 b) { return {a.x - b.x, a.y - b.y}; }
+Vec2 operator*(Vec2 a, double s) { return {a.x * s, a.y * s}; }
+Vec2 midpoint(Vec2 a, Vec2 b) { return {(a.x + b.x) * 0.5, (a.y + b.y) * 0.5}; }
+
+// Turns SVG drawing commands into a polyline. Subpaths are joined end to end,
+// since the transform needs one continuous outline.
+class Flattener {
+public:
+    Flattener(std::vector<Point2D>& out, double tolerance)
+        : out(out), tolerance(tolerance), current{0.0, 0.0}, start{0.0, 0.0} {}
+
+    Vec2 position() const { return current; }
+
+    void moveTo(Vec2 p) {
+        emit(p);
+        current = start = p;
+    }
+
+    void lineTo(Vec2 p) {
+        emit(p);
+        current = p;
+    }
+
+    void cubicTo(Vec2 c1, Vec2 c2, Vec2 p) {
+        cubic(current, c1, c2, p, 0);
+        current = p;
+    }
+
+    void quadTo(Vec2 c, Vec2 p) {
+        // Degree elevation: the same curve as a cubic
+        Vec2 c1 = current + (c - current) * (2.0 / 3.0);
+        Vec2 c2 = p + (c - p) * (2.0 / 3.0);
+        cubicTo(c1, c2, p);
+    }
+
+    // Endpoint-parameterized elliptical arc (SVG implementation notes, F.6.5),
+    // converted to center form and drawn as cubics of at most 90 degrees
+    void arcTo(double rx, double ry, double rotation, bool largeArc, bool sweep, Vec2 p) {
+        rx = std::fabs(rx);
+        ry = std::fabs(ry);
+        if (rx == 0.0 || ry == 0.0 || (p.x == current.x && p.y == current.y)) {
+            lineTo(p);
+            return;
+        }
+
+        double phi = rotation * M_PI / 180.0;
+        double cosPhi = std::cos(phi);
+        double sinPhi = std::sin(phi);
+        double dx = (current.x - p.x) * 0.5;
+        double dy = (current.y - p.y) * 0.5;
+        double x1 = cosPhi * dx + sinPhi * dy;
+        double y1 = -sinPhi * dx + cosPhi * dy;
+
+        // Radii too small to reach the endpoint are scaled up just enough
+        double lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+        if (lambda > 1.0) {
+            rx *= std::sqrt(lambda);
+            ry *= std::sqrt(lambda);
+        }
+
+        double numerator = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+        double denominator = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+        double coefficient = std::sqrt(std::max(0.0, numerator / denominator));
+        if (largeArc == sweep) coefficient = -coefficient;
+        double cx1 = coefficient * rx * y1 / ry;
+        double cy1 = -coefficient * ry * x1 / rx;
+        Vec2 center{cosPhi * cx1 - sinPhi * cy1 + (current.x + p.x) * 0.5,
+                    sinPhi * cx1 + cosPhi * cy1 + (current.y + p.y) * 0.5};
+
+        double theta = std::atan2((y1 - cy1) / ry, (x1 - cx1) / rx);
+        double thetaEnd = std::atan2((-y1 - cy1) / ry, (-x1 - cx1) / rx);
+        double sweepAngle = thetaEnd - theta;
+        if (sweep && sweepAngle < 0.0) sweepAngle += 2.0 * M_PI;
+        if (!sweep && sweepAngle > 0.0) sweepAngle -= 2.0 * M_PI;
+
+        auto toPath = [&](double ux, double uy) {
+            return Vec2{center.x + rx * ux * cosPhi - ry * uy * sinPhi,
+                        center.y + rx * ux * sinPhi + ry * uy * cosPhi};
+        };
+
+        int segments = std::max(1, static_cast<int>(std::ceil(std::fabs(sweepAngle) / (M_PI / 2.0) - 1e-9)));
+        double delta = sweepAngle / segments;
+        double handle = 4.0 / 3.0 * std::tan(delta / 4.0);
+        for (int i = 0; i < segments; i++) {
+            double a0 = theta + i * delta;
+            double a1 = a0 + delta;
+            Vec2 c1 = toPath(std::cos(a0) - handle * std::sin(a0), std::sin(a0) + handle * std::cos(a0));
+            Vec2 c2 = toPath(std::cos(a1) + handle * std::sin(a1), std::sin(a1) - handle * std::cos(a1));
+            Vec2 end = i + 1 == segments ? p : toPath(std::cos(a1), std::sin(a1));
+            cubicTo(c1, c2, end);
+        }
+    }
+
+    void close() {
+        lineTo(start);
+    }
+
+private:
+    std::vector<Point2D>& out;
+    double tolerance;
+    Vec2 current;
+    Vec2 start;
+
+    void emit(Vec2 p) {
+        // Repeated points would give zero-length segments to the resampler
+        Point2D point(static_cast<float>(p.x), static_cast<float>(p.y));
+        if (!out.empty() && out.back().x == point.x && out.back().y == point.y) return;
+        out.push_back(point);
+    }
+
+    // Adaptive de Casteljau subdivision until both control points lie within
+    // tolerance of the chord
+    void cubic(Vec2 p0, Vec2 p1, Vec2 p2, Vec2 p3, int depth) {
+        Vec2 chord = p3 - p0;
+        double length = std::hypot(chord.x, chord.y);
+        double d1, d2;
+        if (length > 1e-12) {
+            d1 = std::fabs((p1.x - p0.x) * chord.y - (p1.y - p0.y) * chord.x) / length;
+            d2 = std::fabs((p2.x - p0.x) * chord.y - (p2.y - p0.y) * chord.x) / length;
+        } else {
+            d1 = std::hypot(p1.x - p0.x, p1.y - p0.y);
+            d2 = std::hypot(p2.x - p0.x, p2.y - p0.y);
+        }
+        if (std::max(d1, d2) <= tolerance || depth >= MAX_FLATTEN_DEPTH) {
+            emit(p3);
+            return;
+        }
+
+        Vec2 p01 = midpoint(p0, p1), p12 = midpoint(p1, p2), p23 = midpoint(p2, p3);
+        Vec2 p012 = midpoint(p01, p12), p123 = midpoint(p12, p23);
+        Vec2 mid = midpoint(p012, p123);
+        cubic(p0, p01, p012, mid, depth + 1);
+        cubic(mid, p123, p23, p3, depth + 1);
+    }
+};
+
+void skipSeparators(const char*& p, const char* end) {
+    while (p < end && (isSpace(*p) || *p == ',')) p++;
+}
+
+bool readCoordinate(const char*& p, const char* end, double& value) {
+    skipSeparators(p, end);
+    return readNumber(p, end, value);
+}
+
+bool readPoint(const char*& p, const char* end, Vec2& point) {
+    return readCoordinate(p, end, point.x) && readCoordinate(p, end, point.y);
+}
+
+// Arc flags are single digits and may be written without separators ("a5 5 0 01 9 9")
+bool readFlag(const char*& p, const char* end, bool& flag) {
+    skipSeparators(p, end);
+    if (p >= end || (*p != '0' && *p != '1')) return false;
+    flag = *p++ == '1';
+    return true;
+}
+
+// Parse one path's d attribute. Returns false on malformed data.
+bool parsePathData(const char* p, const char* end, Flattener& flattener) {
+    char command = 0;
+    char previous = 0;       // Last command run, upper case, for S/T reflection
+    Vec2 lastControl{0.0, 0.0};
+
+    for (;;) {
+        skipSeparators(p, end);
+        if (p >= end) return true;
+
+        if (std::isalpha(static_cast<unsigned char>(*p))) {
+            command = *p++;
+        } else if (command == 0) {
+            return false;  // Numbers with no command to repeat
+        }
+
+        bool relative = std::islower(static_cast<unsigned char>(command)) != 0;
+        char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(command)));
+        Vec2 origin = relative ? flattener.position() : Vec2{0.0, 0.0};
+        Vec2 current = flattener.position();
+
+        switch (upper) {
+            case 'M': {
+                Vec2 point;
+                if (!readPoint(p, end, point)) return false;
+                flattener.moveTo(origin + point);
+                command = relative ? 'l' : 'L';  // Further pairs are line segments
+                break;
+            }
+            case 'L': {
+                Vec2 point;
+                if (!readPoint(p, end, point)) return false;
+                flattener.lineTo(origin + point);
+                break;
+            }
+            case 'H': {
+                double x;
+                if (!readCoordinate(p, end, x)) return false;
+                flattener.lineTo({origin.x + x, current.y});
+                break;
+            }
+            case 'V': {
+                double y;
+                if (!readCoordinate(p, end, y)) return false;
+                flattener.lineTo({current.x, origin.y + y});
+                break;
+            }
+            case 'C': {
+                Vec2 c1, c2, point;
+                if (!readPoint(p, end, c1) || !readPoint(p, end, c2) || !readPoint(p, end, point)) return false;
+                flattener.cubicTo(origin + c1, origin + c2, origin + point);
+                lastControl = origin + c2;
+                break;
+            }
+            case 'S': {
+                Vec2 c2, point;
+                if (!readPoint(p, end, c2) || !readPoint(p, end, point)) return false;
+                Vec2 c1 = (previous == 'C' || previous == 'S') ? current + (current - lastControl) : current;
+                flattener.cubicTo(c1, origin + c2, origin + point);
+                lastControl = origin + c2;
+                break;
+            }
+            case 'Q': {
+                Vec2 c, point;
+                if (!readPoint(p, end, c) || !readPoint(p, end, point)) return false;
+                flattener.quadTo(origin + c, origin + point);
+                lastControl = origin + c;
+                break;
+            }
+            case 'T': {
+                Vec2 point;
+                if (!readPoint(p, end, point)) return false;
+                Vec2 c = (previous == 'Q' || previous == 'T') ? current + (current - lastControl) : current;
+                flattener.quadTo(c, origin + point);
+                lastControl = c;
+                break;
+            }
+            case 'A': {
+                double rx, ry, rotation;
+                bool largeArc, sweep;
+                Vec2 point;
+                if (!readCoordinate(p, end, rx) || !readCoordinate(p, end, ry) ||
+                    !readCoordinate(p, end, rotation) || !readFlag(p, end, largeArc) ||
+                    !readFlag(p, end, sweep) || !readPoint(p, end, point)) {
+                    return false;
+                }
+                flattener.arcTo(rx, ry, rotation, largeArc, sweep, origin + point);
+                break;
+            }
+            case 'Z':
+                flattener.close();
+                command = 0;  // Only a new command may follow
+                break;
+            default:
+                return false;
+        }
+        previous = upper;
+    }
+}
+
+// Find the next "<path ... d=..." tag at or after p; sets [dBegin, dEnd) to the
+// attribute value and returns the position after the tag, or end if none is left
+const char* findPathData(const char* p, const char* end, const char*& dBegin, const char*& dEnd) {
+    static const char TAG[] = "<path";
+    const std::size_t tagLength = sizeof(TAG) - 1;
+
+    while (p < end) {
+        const char* open = static_cast<const char*>(std::memchr(p, '<', end - p));
+        if (!open) return end;
+
+        // Skip comments, which may contain markup
+        if (end - open >= 4 && std::memcmp(open, "<!--", 4) == 0) {
+            const char* close = std::search(open + 4, end, "-->", "-->" + 3);
+            p = close == end ? end : close + 3;
+            continue;
+        }
+
+        p = open + 1;
+        if (static_cast<std::size_t>(end - open) <= tagLength ||
+            std::memcmp(open, TAG, tagLength) != 0 || !isSpace(open[tagLength])) {
+            continue;
+        }
+
+        // Walk the attributes up to '>' looking for d="..."
+        const char* s = open + tagLength;
+        while (s < end && *s != '>') {
+            while (s < end && isSpace(*s)) s++;
+            const char* name = s;
+            while (s < end && !isSpace(*s) && *s != '=' && *s != '>') s++;
+            std::size_t nameLength = s - name;
+            while (s < end && isSpace(*s)) s++;
+            if (s >= end || *s != '=') {
+                if (s < end && *s != '>' && nameLength == 0) s++;  // Stray character ('/')
+                continue;
+            }
+            s++;
+            while (s < end && isSpace(*s)) s++;
+            if (s >= end || (*s != '"' && *s != '\'')) break;
+
+            char quote = *s++;
+            const char* value = s;
+            const char* valueEnd = static_cast<const char*>(std::memchr(s, quote, end - s));
+            if (!valueEnd) return end;
+            s = valueEnd + 1;
+
+            if (nameLength == 1 && *name == 'd') {
+                dBegin = value;
+                dEnd = valueEnd;
+                const char* tagEnd = static_cast<const char*>(std::memchr(s, '>', end - s));
+                return tagEnd ? tagEnd + 1 : end;
+            }
+        }
+        p = s;
+    }
+    return end;
+}
+
+std::string lowerExtension(const std::string& filename) {
+    std::size_t dot = filename.find_last_of('.');
+    std::size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return "";
+    std::string extension = filename.substr(dot + 1);
+    for (char& c : extension) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return extension;
+}
+
+PathLoader::Format detectFormat(const std::string& filename, const char* data, std::size_t size) {
+    std::string extension = lowerExtension(filename);
+    if (extension == "svg") return PathLoader::Format::SVG;
+    if (extension == "csv" || extension == "txt") return PathLoader::Format::CSV;
+    if (extension == "fpts" || extension == "bin") return PathLoader::Format::Binary;
+
+    if (size >= sizeof(BINARY_MAGIC) && std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0) {
+        return PathLoader::Format::Binary;
+    }
+    const char* sniffEnd = data + std::min(size, SNIFF_BYTES);
+    static const char SVG_TAG[] = "<svg";
+    static const char PATH_TAG[] = "<path";
+    if (std::search(data, sniffEnd, SVG_TAG, SVG_TAG + 4) != sniffEnd ||
+        std::search(data, sniffEnd, PATH_TAG, PATH_TAG + 5) != sniffEnd) {
+        return PathLoader::Format::SVG;
+    }
+    return PathLoader::Format::CSV;
+}
+
+// Use the point array in place when the mapping allows it, else copy it out
+bool readBinary(const std::string& filename, const char* data, std::size_t size,
+                std::vector<Point2D>& owned, const Point2D*& points, std::size_t& count) {
+    if (size < BINARY_HEADER_SIZE || std::memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        std::cerr << filename << " is not a binary point file" << std::endl;
+        return false;
+    }
+
+    std::uint32_t version;
+    std::uint64_t stored;
+    std::memcpy(&version, data + 4, sizeof(version));
+    std::memcpy(&stored, data + 8, sizeof(stored));
+    bool little = isLittleEndian();
+    if (!little) {
+        swapBytes(&version, sizeof(version));
+        swapBytes(&stored, sizeof(stored));
+    }
+    if (version != BINARY_VERSION) {
+        std::cerr << filename << ": unsupported binary point format version " << version << std::endl;
+        return false;
+    }
+    if (stored > (size - BINARY_HEADER_SIZE) / sizeof(Point2D)) {
+        std::cerr << filename << " is truncated (" << stored << " points in the header)" << std::endl;
+        return false;
+    }
+
+    const char* payload = data + BINARY_HEADER_SIZE;
+    count = static_cast<std::size_t>(stored);
+    if (little && reinterpret_cast<std::uintptr_t>(payload) % alignof(Point2D) == 0) {
+        points = reinterpret_cast<const Point2D*>(payload);
+        return true;
+    }
+
+    owned.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        float xy[2];
+        std::memcpy(xy, payload + i * sizeof(xy), sizeof(xy));
+        if (!little) {
+            swapBytes(&xy[0], sizeof(float));
+            swapBytes(&xy[1], sizeof(float));
+        }
+        owned[i] = Point2D(xy[0], xy[1]);
+    }
+    points = owned.data();
+    return true;
+}
+
+} // namespace
+
+LoadedPath::LoadedPath() : points(nullptr), count(0) {
+}
+
+bool PathLoader::load(const std::string& filename, LoadedPath& out, Format format) {
+    out.owned.clear();
+    out.points = nullptr;
+    out.count = 0;
+    if (!out.mapping.open(filename)) return false;
+
+    const char* data = out.mapping.data();
+    std::size_t size = out.mapping.size();
+    if (format == Format::Auto) format = detectFormat(filename, data, size);
+
+    bool ok = false;
+    switch (format) {
+        case Format::Binary:
+            ok = readBinary(filename, data, size, out.owned, out.points, out.count);
+            break;
+        case Format::SVG:
+            ok = parseSVG(data, size, out.owned);
+            break;
+        case Format::CSV:
+        case Format::Auto:
+            ok = parseCSV(data, size, out.owned);
+            break;
+    }
+    if (!ok) {
+        std::cerr << "Failed to load path from " << filename << std::endl;
+        out.mapping.close();
+        out.owned.clear();
+        return false;
+    }
+
+    // Text formats were parsed into owned storage; the mapping is no longer needed
+    if (format != Format::Binary) {
+        out.mapping.close();
+        out.points = out.owned.data();
+        out.count = out.owned.size();
+    } else if (out.points != nullptr && out.points == out.owned.data()) {
+        out.mapping.close();
+    }
+    return true;
+}
+
+bool PathLoader::parseSVG(const char* text, std::size_t length, std::vector<Point2D>& out, float tolerance) {
+    out.clear();
+    Flattener flattener(out, std::max(1e-6, static_cast<double>(tolerance)));
+
+    const char* end = text + length;
+    const char* p = text;
+    int paths = 0;
+    while (p < end) {
+        const char* dBegin = nullptr;
+        const char* dEnd = nullptr;
+        p = findPathData(p, end, dBegin, dEnd);
+        if (!dBegin) break;
+
+        paths++;
+        if (!parsePathData(dBegin, dEnd, flattener)) {
+            std::cerr << "Malformed SVG path data in path " << paths << std::endl;
+            return false;
+        }
+    }
+
+    if (out.size() < 2) {
+        std::cerr << "SVG contains no drawable <path> data" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PathLoader::parseCSV(const char* text, std::size_t length, std::vector<Point2D>& out) {
+    out.clear();
+    const char* end = text + length;
+    const char* p = text;
+    int skipped = 0;
+
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!lineEnd) lineEnd = end;
+
+        const char* s = p;
+        while (s < lineEnd && isSpace(*s)) s++;
+        if (s < lineEnd && *s != '#') {
+            double x, y;
+            bool parsed = readNumber(s, lineEnd, x);
+            if (parsed) {
+                while (s < lineEnd && (isSpace(*s) || *s == ',' || *s == ';')) s++;
+                parsed = readNumber(s, lineEnd, y);
+            }
+            if (parsed) {
+                out.push_back(Point2D(static_cast<float>(x), static_cast<float>(y)));
+            } else {
+                skipped++;  // Header row or junk
+            }
+        }
+        p = lineEnd + 1;
+    }
+
+    if (skipped > 1) {
+        std::cerr << "Skipped " << skipped << " CSV lines that are not x,y pairs" << std::endl;
+    }
+    if (out.empty()) {
+        std::cerr << "CSV contains no x,y points" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PathLoader::writeBinary(const std::string& filename, const Point2D* points, std::size_t count) {
+    FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to create " << filename << std::endl;
+        return false;
+    }
+
+    bool little = isLittleEndian();
+    std::uint32_t version = BINARY_VERSION;
+    std::uint64_t stored = count;
+    if (!little) {
+        swapBytes(&version, sizeof(version));
+        swapBytes(&stored, sizeof(stored));
+    }
+    std::fwrite(BINARY_MAGIC, 1, sizeof(BINARY_MAGIC), file);
+    std::fwrite(&version, sizeof(version), 1, file);
+    std::fwrite(&stored, sizeof(stored), 1, file);
+
+    if (little) {
+        std::fwrite(points, sizeof(Point2D), count, file);
+    } else {
+        for (std::size_t i = 0; i < count; i++) {
+            float xy[2] = {points[i].x, points[i].y};
+            swapBytes(&xy[0], sizeof(float));
+            swapBytes(&xy[1], sizeof(float));
+            std::fwrite(xy, sizeof(float), 2, file);
+        }
+    }
+
+    bool written = !std::ferror(file);
+    if (std::fclose(file) != 0 || !written) {
+        std::cerr << "Failed to write " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
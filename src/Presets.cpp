@@ -0,0 +1,240 @@
+#include "Presets.h"
+#include <array>
+
+namespace {
+
+// Everything below runs at compile time. std::cos and friends are not constexpr
+// in C++17, so the shapes and their spectra use series that are accurate to a
+// few ulps in double over the ranges needed here.
+
+constexpr double PI = 3.14159265358979323846;
+
+// Angle in [-π, π] with the same sine and cosine
+constexpr double reduceAngle(double x) {
+    double turns = x / (2.0 * PI);
+    long long whole = static_cast<long long>(turns >= 0.0 ? turns + 0.5 : turns - 0.5);
+    return x - static_cast<double>(whole) * 2.0 * PI;
+}
+
+constexpr double sine(double x) {
+    x = reduceAngle(x);
+    double term = x, sum = x;
+    for (int n = 1; n < 18; n++) {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cosine(double x) {
+    x = reduceAngle(x);
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 18; n++) {
+        term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double squareRoot(double x) {
+    if (x <= 0.0) return 0.0;
+    // Newton from above converges monotonically; stop once it stops moving
+    double root = x > 1.0 ? x : 1.0;
+    for (int i = 0; i < 200; i++) {
+        double next = 0.5 * (root + x / root);
+        if (next >= root) break;
+        root = next;
+    }
+    return root;
+}
+
+constexpr double arcTangent(double x) {
+    bool inverted = x > 1.0 || x < -1.0;
+    double y = inverted ? 1.0 / x : x;
+
+    // Halve the angle twice, atan(y) = 2 atan(y / (1 + sqrt(1 + y²))), so the
+    // series below only sees |y| <= tan(π/16)
+    for (int i = 0; i < 2; i++) y = y / (1.0 + squareRoot(1.0 + y * y));
+    double power = y, sum = 0.0;
+    for (int n = 0; n < 24; n++) {
+        sum += (n % 2 == 0 ? power : -power) / (2.0 * n + 1.0);
+        power *= y * y;
+    }
+    double angle = 4.0 * sum;
+    if (inverted) angle = (x > 0.0 ? PI / 2.0 : -PI / 2.0) - angle;
+    return angle;
+}
+
+// Same quadrants as std::atan2
+constexpr double arcTangent2(double y, double x) {
+    if (x > 0.0) return arcTangent(y / x);
+    if (x < 0.0) return arcTangent(y / x) + (y < 0.0 ? -PI : PI);
+    if (y > 0.0) return PI / 2.0;
+    if (y < 0.0) return -PI / 2.0;
+    return 0.0;
+}
+
+// e^(-i*2π*j/N) for the DFT of each built-in length
+template <int N>
+struct Twiddles {
+    std::array<double, N> re{};
+    std::array<double, N> im{};
+};
+
+template <int N>
+constexpr Twiddles<N> makeTwiddles() {
+    Twiddles<N> twiddles;
+    for (int j = 0; j < N; j++) {
+        twiddles.re[j] = cosine(2.0 * PI * j / N);
+        twiddles.im[j] = -sine(2.0 * PI * j / N);
+    }
+    return twiddles;
+}
+
+template <int N>
+struct PresetTable {
+    static_assert(N % 2 == 0, "Frequencies -N/2..N/2-1 need an even length");
+
+    std::array<Point2D, N> points{};
+    std::array<double, N> re{};
+    std::array<double, N> im{};
+    std::array<int, N> frequency{};
+    std::array<double, N> radius{};
+    std::array<double, N> phase{};
+    std::array<int, N> prefixMaxFrequency{};
+    float extent = 0.f;
+};
+
+// Sample shape(i) for i in [0, N), then transform the points exactly as
+// FourierEngine does: coefficient k is X[k mod N] / N for k in [-N/2, N/2),
+// sorted by magnitude, largest first (equal magnitudes keep frequency order)
+template <int N, typename Shape>
+constexpr PresetTable<N> makePreset(Shape shape) {
+    constexpr Twiddles<N> twiddles = makeTwiddles<N>();
+    PresetTable<N> table;
+
+    float minX = 0.f, maxX = 0.f, minY = 0.f, maxY = 0.f;
+    for (int i = 0; i < N; i++) {
+        table.points[i] = shape(i);
+        const Point2D& p = table.points[i];
+        if (i == 0 || p.x < minX) minX = p.x;
+        if (i == 0 || p.x > maxX) maxX = p.x;
+        if (i == 0 || p.y < minY) minY = p.y;
+        if (i == 0 || p.y > maxY) maxY = p.y;
+    }
+    table.extent = maxX - minX > maxY - minY ? maxX - minX : maxY - minY;
+
+    std::array<double, N> re{}, im{}, magnitude{};
+    std::array<int, N> order{};
+    for (int i = 0; i < N; i++) {
+        int k = i - N / 2;
+        int bin = (k + N) % N;
+        double sumRe = 0.0, sumIm = 0.0;
+        for (int n = 0; n < N; n++) {
+            int j = (bin * n) % N;
+            double x = table.points[n].x, y = table.points[n].y;
+            sumRe += x * twiddles.re[j] - y * twiddles.im[j];
+            sumIm += x * twiddles.im[j] + y * twiddles.re[j];
+        }
+        re[i] = sumRe / N;
+        im[i] = sumIm / N;
+        magnitude[i] = squareRoot(re[i] * re[i] + im[i] * im[i]);
+        order[i] = i;
+    }
+
+    // Insertion sort (stable) by magnitude
+    for (int i = 1; i < N; i++) {
+        int index = order[i];
+        int j = i;
+        for (; j > 0 && magnitude[order[j - 1]] < magnitude[index]; j--) order[j] = order[j - 1];
+        order[j] = index;
+    }
+
+    int maxFrequency = 0;
+    for (int i = 0; i < N; i++) {
+        int source = order[i];
+        int k = source - N / 2;
+        table.re[i] = re[source];
+        table.im[i] = im[source];
+        table.frequency[i] = k;
+        table.radius[i] = magnitude[source];
+        table.phase[i] = arcTangent2(im[source], re[source]);
+        if ((k < 0 ? -k : k) > maxFrequency) maxFrequency = k < 0 ? -k : k;
+        table.prefixMaxFrequency[i] = maxFrequency;
+    }
+    return table;
+}
+
+// The built-in shapes, at the sizes the app shows them. Same curves as the
+// PathData::create* functions, evaluated in double and rounded once; run
+// fourier-check-presets (bench/PresetCheck.cpp) after changing either.
+
+constexpr PresetTable<100> CIRCLE = makePreset<100>([](int i) {
+    double angle = 2.0 * PI * i / 100;
+    return Point2D(static_cast<float>(120.0 * cosine(angle)), static_cast<float>(120.0 * sine(angle)));
+});
+
+constexpr PresetTable<200> SQUARE = makePreset<200>([](int i) {
+    const double size = 250.0, half = size / 2.0;
+    int side = i / 50;
+    double t = (i % 50) / 50.0;
+    switch (side) {
+        case 0:  return Point2D(static_cast<float>(-half + t * size), static_cast<float>(-half));  // Top
+        case 1:  return Point2D(static_cast<float>(half), static_cast<float>(-half + t * size));   // Right
+        case 2:  return Point2D(static_cast<float>(half - t * size), static_cast<float>(half));    // Bottom
+        default: return Point2D(static_cast<float>(-half), static_cast<float>(half - t * size));   // Left
+    }
+});
+
+constexpr PresetTable<200> STAR = makePreset<200>([](int i) {
+    const double outer = 120.0, inner = 0.4 * outer;
+    const int spikes = 5;
+    double t = i / 200.0;
+    double angle = t * 2.0 * PI - PI / 2.0;  // Start from the top
+    double spikePosition = t * spikes;
+    double withinSpike = spikePosition - static_cast<int>(spikePosition);
+    double factor = withinSpike < 0.5 ? 1.0 - withinSpike * 2.0 : (withinSpike - 0.5) * 2.0;
+    double r = inner + (outer - inner) * factor;
+    return Point2D(static_cast<float>(r * cosine(angle)), static_cast<float>(r * sine(angle)));
+});
+
+constexpr PresetTable<200> HEART = makePreset<200>([](int i) {
+    const double scale = 10.0;
+    double t = 2.0 * PI * i / 200 - PI;
+    double s = sine(t);
+    double x = 16.0 * s * s * s;
+    double y = 13.0 * cosine(t) - 5.0 * cosine(2.0 * t) - 2.0 * cosine(3.0 * t) - cosine(4.0 * t);
+    return Point2D(static_cast<float>(x * scale), static_cast<float>(-y * scale));  // Right side up
+});
+
+constexpr PresetTable<200> INFINITY_SHAPE = makePreset<200>([](int i) {
+    const double scale = 120.0;
+    double t = 2.0 * PI * i / 200;
+    return Point2D(static_cast<float>(scale * cosine(t)), static_cast<float>(scale * sine(t) * cosine(t)));
+});
+
+template <int N>
+constexpr PresetShape describe(const char* name, const PresetTable<N>& table) {
+    return {name, table.points.data(), N,
+            table.re.data(), table.im.data(), table.frequency.data(),
+            table.radius.data(), table.phase.data(), table.prefixMaxFrequency.data(),
+            N, table.extent};
+}
+
+constexpr PresetShape SHAPES[Presets::COUNT] = {
+    describe("Circle", CIRCLE),
+    describe("Square", SQUARE),
+    describe("Star", STAR),
+    describe("Heart", HEART),
+    describe("Infinity", INFINITY_SHAPE),
+};
+
+} // namespace
+
+namespace Presets {
+
+const PresetShape& get(int index) {
+    return (index >= 1 && index <= COUNT) ? SHAPES[index - 1] : SHAPES[0];
+}
+
+} // namespace Presets
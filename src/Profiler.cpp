@@ -0,0 +1,97 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Initial room for trace events: about a minute at 60 FPS
+const std::size_t TRACE_RESERVE = 60 * 60 * static_cast<int>(ProfileZone::Count);
+
+} // namespace
+
+Profiler::Profiler() : enabled(false), tracing(false), origin(Clock::now()) {
+    historySize.fill(0);
+    historyNext.fill(0);
+}
+
+void Profiler::setEnabled(bool on) {
+    // A trace keeps recording regardless of the overlay
+    enabled = on || tracing;
+}
+
+void Profiler::startTrace() {
+    tracing = true;
+    enabled = true;
+    trace.reserve(TRACE_RESERVE);
+}
+
+void Profiler::record(ProfileZone zone, Clock::time_point start, Clock::time_point end) {
+    int index = static_cast<int>(zone);
+    double durationMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    history[index][historyNext[index]] = static_cast<float>(durationMs);
+    historyNext[index] = (historyNext[index] + 1) % HISTORY;
+    historySize[index] = std::min(historySize[index] + 1, HISTORY);
+
+    if (tracing) {
+        double startUs = std::chrono::duration<double, std::micro>(start - origin).count();
+        trace.push_back({zone, startUs, durationMs * 1000.0});
+    }
+}
+
+Profiler::ZoneStats Profiler::getStats(ProfileZone zone) const {
+    int index = static_cast<int>(zone);
+    ZoneStats stats;
+    stats.samples = historySize[index];
+    if (stats.samples == 0) return stats;
+
+    const std::array<float, HISTORY>& samples = history[index];
+    double sum = 0.0;
+    float minimum = samples[0];
+    for (int i = 0; i < stats.samples; i++) {
+        sum += samples[i];
+        minimum = std::min(minimum, samples[i]);
+    }
+
+    // p99: the sample 99% of the way up, found without sorting the history itself
+    std::copy(samples.begin(), samples.begin() + stats.samples, sortScratch.begin());
+    int rank = (stats.samples - 1) * 99 / 100;
+    std::nth_element(sortScratch.begin(), sortScratch.begin() + rank,
+                     sortScratch.begin() + stats.samples);
+
+    stats.minMs = minimum;
+    stats.avgMs = sum / stats.samples;
+    stats.p99Ms = sortScratch[rank];
+    return stats;
+}
+
+bool Profiler::writeTrace(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    // Complete events ("ph":"X") on a single thread; timestamps in microseconds
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (std::size_t i = 0; i < trace.size(); i++) {
+        const TraceEvent& event = trace[i];
+        std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}%s\n",
+                     zoneName(event.zone), event.startUs, event.durationUs,
+                     i + 1 < trace.size() ? "," : "");
+    }
+    std::fprintf(file, "]}\n");
+    bool written = !std::ferror(file);
+    return std::fclose(file) == 0 && written;
+}
+
+const char* Profiler::zoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::Frame:     return "Frame";
+        case ProfileZone::Events:    return "Events";
+        case ProfileZone::Transform: return "Transform";
+        case ProfileZone::Evaluate:  return "Evaluate";
+        case ProfileZone::Trail:     return "Trail";
+        case ProfileZone::Render:    return "Render";
+        case ProfileZone::UI:        return "UI";
+        case ProfileZone::Present:   return "Present";
+        default:                     return "Unknown";
+    }
+}
@@ -2,7 +2,120 @@
 #include <algorithm>
 #include <cmath>
 
-Renderer::Renderer() {
+namespace {
+
+// Same tessellation sf::CircleShape uses by default (glow discs)
+const int CIRCLE_SEGMENTS = 30;
+const int DOT_SEGMENTS = 8;
+
+// Epicycle circle levels: 8, 16, ..., 256 segments
+const int MIN_CIRCLE_SEGMENTS = 8;
+const int CIRCLE_LEVELS = 6;
+
+// Least distance (pixels) between the dots on the stroke being drawn
+const float USER_PATH_DOT_SPACING = 8.f;
+
+// Meshes of trails not drawn for this many frames are freed
+const std::uint64_t TRAIL_MESH_IDLE_FRAMES = 120;
+
+// Trail vertices carry their point's sequence number modulo this (exact in a float)
+const std::uint64_t TRAIL_SEQUENCE_WRAP = 1 << 20;
+
+// Colors each trail vertex by t = (sequence - base) / span along the
+// pink -> cyan -> purple gradient. Fading trails also fade in alpha, so moving
+// the trail forward only changes the uniforms.
+const char* TRAIL_VERTEX_SHADER = R"(
+uniform float base;
+uniform float span;
+uniform float wrap;
+uniform float fade;
+
+void main() {
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+    float t = clamp(mod(gl_MultiTexCoord0.x - base + wrap, wrap) / span, 0.0, 1.0);
+    vec3 pink = vec3(1.0, 0.431, 0.780);
+    vec3 cyan = vec3(0.0, 0.941, 1.0);
+    vec3 purple = vec3(0.725, 0.404, 1.0);
+    vec3 color = t < 0.5 ? mix(pink, cyan, t * 2.0) : mix(cyan, purple, (t - 0.5) * 2.0);
+    gl_FrontColor = vec4(color, fade > 0.5 ? min(t * t * 1.6, 1.0) : 1.0);
+}
+)";
+
+std::vector<sf::Vector2f> makeUnitCircle(int segments) {
+    std::vector<sf::Vector2f> points(segments);
+    for (int i = 0; i < segments; i++) {
+        float angle = 2.0f * M_PI * i / segments;
+        points[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+    }
+    return points;
+}
+
+} // namespace
+
+Renderer::Renderer()
+    : unitCircle(makeUnitCircle(CIRCLE_SEGMENTS)),
+      unitDot(makeUnitCircle(DOT_SEGMENTS)),
+      cullRadius(0.5f),
+      tessellationTolerance(0.25f),
+      frameNumber(0),
+      trailShaderLoaded(false),
+      trailShaderTried(false),
+      trailVertices(sf::PrimitiveType::Lines),
+      circleVertices(sf::PrimitiveType::Lines),
+      dotVertices(sf::PrimitiveType::Triangles),
+      pointVertices(sf::PrimitiveType::Points),
+      armVertices(sf::PrimitiveType::LineStrip),
+      armLineVertices(sf::PrimitiveType::Lines),
+      glowVertices(sf::PrimitiveType::Triangles),
+      pathVertices(sf::PrimitiveType::LineStrip),
+      outlineVertices(sf::PrimitiveType::LineStrip) {
+    for (int level = 0; level < CIRCLE_LEVELS; level++) {
+        circleLevels.push_back(makeUnitCircle(MIN_CIRCLE_SEGMENTS << level));
+    }
+}
+
+void Renderer::beginFrame() {
+    stats = RenderStats();
+
+    // Trails not drawn for a while are gone or hidden; a hidden one is rebuilt when shown
+    frameNumber++;
+    for (auto it = trailMeshes.begin(); it != trailMeshes.end();) {
+        if (frameNumber - it->second.lastFrame > TRAIL_MESH_IDLE_FRAMES) {
+            it = trailMeshes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const RenderStats& Renderer::getStats() const {
+    return stats;
+}
+
+void Renderer::setCullRadius(float pixels) {
+    cullRadius = std::max(pixels, 0.f);
+}
+
+void Renderer::setTessellationTolerance(float pixels) {
+    tessellationTolerance = std::max(pixels, 0.01f);
+}
+
+void Renderer::submit(sf::RenderTarget& target, const sf::VertexArray& vertices,
+                      const sf::RenderStates& states) {
+    if (vertices.getVertexCount() == 0) return;
+    target.draw(vertices, states);
+    stats.vertices += static_cast<int>(vertices.getVertexCount());
+    stats.drawCalls++;
+}
+
+const std::vector<sf::Vector2f>& Renderer::circleForRadius(float pixelRadius) const {
+    // A chord spanning angle θ sags r*θ²/8 below the arc, so keeping the sag under
+    // the tolerance needs θ <= sqrt(8*tol/r), i.e. 2π/θ segments
+    float needed = 2.0f * M_PI / std::sqrt(8.0f * tessellationTolerance / pixelRadius);
+    for (const auto& level : circleLevels) {
+        if (static_cast<float>(level.size()) >= needed) return level;
+    }
+    return circleLevels.back();
 }
 
 sf::Color Renderer::lerpColor(sf::Color a, sf::Color b, float t) {
@@ -13,108 +126,294 @@ sf::Color Renderer::lerpColor(sf::Color a, sf::Color b, float t) {
     );
 }
 
-void Renderer::drawTrail(sf::RenderWindow& window, const std::vector<Point2D>& trail) {
-    if (trail.size() > 1) {
-        for (size_t i = 1; i < trail.size(); i++) {
-            // Quadratic fade for smoother effect
-            float t = static_cast<float>(i) / trail.size();
-            float fade = t * t;  // Quadratic easing
-            int alpha = static_cast<int>(fade * 255 * 1.6f);  // Bolder trail
-            alpha = std::min(alpha, 255);
-
-            // Color gradient along trail: Pink -> Cyan -> Purple
-            sf::Color color;
-            if (t < 0.5f) {
-                // Pink to Cyan
-                color = lerpColor(
-                    sf::Color(255, 110, 199),  // Neon Pink
-                    sf::Color(0, 240, 255),    // Cyan
-                    t * 2.0f
-                );
-            } else {
-                // Cyan to Purple
-                color = lerpColor(
-                    sf::Color(0, 240, 255),    // Cyan
-                    sf::Color(185, 103, 255),  // Purple
-                    (t - 0.5f) * 2.0f
-                );
+void Renderer::colorEpicycles(Epicycle* epicycles, int count) {
+    for (int i = 0; i < count; i++) {
+        float t = std::min(static_cast<float>(i) / std::min(count, 5), 1.0f);
+        epicycles[i].color = t < 0.5f
+            ? lerpColor(sf::Color(255, 110, 199), sf::Color(0, 240, 255), t * 2.0f)   // Pink to Cyan
+            : lerpColor(sf::Color(0, 240, 255), sf::Color(185, 103, 255), (t - 0.5f) * 2.0f);  // Cyan to Purple
+    }
+}
+
+void Renderer::appendCircle(sf::VertexArray& vertices, const std::vector<sf::Vector2f>& unit,
+                            sf::Vector2f center, float radius, sf::Color color) {
+    int segments = static_cast<int>(unit.size());
+    for (int i = 0; i < segments; i++) {
+        const sf::Vector2f& a = unit[i];
+        const sf::Vector2f& b = unit[(i + 1) % segments];
+        vertices.append(sf::Vertex{{center.x + a.x * radius, center.y + a.y * radius}, color});
+        vertices.append(sf::Vertex{{center.x + b.x * radius, center.y + b.y * radius}, color});
+    }
+}
+
+void Renderer::appendDisc(sf::VertexArray& vertices, const std::vector<sf::Vector2f>& unit,
+                          sf::Vector2f center, float radius, sf::Color color) {
+    int segments = static_cast<int>(unit.size());
+    for (int i = 0; i < segments; i++) {
+        const sf::Vector2f& a = unit[i];
+        const sf::Vector2f& b = unit[(i + 1) % segments];
+        vertices.append(sf::Vertex{center, color});
+        vertices.append(sf::Vertex{{center.x + a.x * radius, center.y + a.y * radius}, color});
+        vertices.append(sf::Vertex{{center.x + b.x * radius, center.y + b.y * radius}, color});
+    }
+}
+
+Renderer::TrailMesh& Renderer::updateTrailMesh(const TrailBuffer& trail) {
+    const int chunkVertices = 2 * TrailBuffer::CHUNK_SIZE;
+    TrailMesh& mesh = trailMeshes[trail.getId()];
+    mesh.lastFrame = frameNumber;
+    if (mesh.versions.size() != static_cast<std::size_t>(trail.chunkCount())) {
+        mesh.vertices.assign(trail.chunkCount() * chunkVertices, sf::Vertex{});
+        mesh.versions.assign(trail.chunkCount(), ~std::uint64_t(0));
+        // Without the shader colors change every frame, so vertices are drawn from memory
+        mesh.useBuffer = trailShaderLoaded && sf::VertexBuffer::isAvailable() &&
+                         mesh.buffer.create(mesh.vertices.size());
+    }
+
+    for (int k = 0, chunk = trail.oldestChunk(); k < trail.usedChunkCount(); k++) {
+        if (mesh.versions[chunk] != trail.chunkVersion(chunk)) {
+            // Segment j joins point j to point j + 1, the last one reaching into the next chunk
+            const Point2D* points = trail.chunkPoints(chunk);
+            int count = trail.chunkSize(chunk);
+            int next = trail.nextChunk(chunk);
+            float sequence = static_cast<float>(trail.chunkSequence(chunk) % TRAIL_SEQUENCE_WRAP);
+            sf::Vertex* out = mesh.vertices.data() + chunk * chunkVertices;
+            for (int j = 0; j < count; j++) {
+                bool last = j == count - 1;
+                if (last && next < 0) break;
+                const Point2D& end = last ? trail.chunkPoints(next)[0] : points[j + 1];
+                out[2 * j] = sf::Vertex{points[j].toSFML(), sf::Color::White, {sequence + j, 0.f}};
+                out[2 * j + 1] = sf::Vertex{end.toSFML(), sf::Color::White, {sequence + j + 1, 0.f}};
             }
+            if (mesh.useBuffer && !mesh.buffer.update(out, chunkVertices, chunk * chunkVertices)) {
+                mesh.useBuffer = false;  // The copy in memory is always complete
+            }
+            mesh.versions[chunk] = trail.chunkVersion(chunk);
+        }
+        chunk = (chunk + 1) % trail.chunkCount();
+    }
+    return mesh;
+}
+
+void Renderer::submitTrailChunks(sf::RenderTarget& target, const TrailBuffer& trail, const TrailMesh& mesh,
+                                 int first, int count, const sf::RenderStates& states) {
+    if (count <= 0) return;
+
+    // Every chunk but the newest is full, so the range is contiguous
+    int lastChunk = first + count - 1;
+    int lastSegments = trail.chunkSize(lastChunk) - (trail.nextChunk(lastChunk) < 0 ? 1 : 0);
+    std::size_t begin = static_cast<std::size_t>(first) * 2 * TrailBuffer::CHUNK_SIZE;
+    std::size_t vertexCount = static_cast<std::size_t>(count - 1) * 2 * TrailBuffer::CHUNK_SIZE +
+                              2 * std::max(lastSegments, 0);
+    if (vertexCount == 0) return;
+
+    if (mesh.useBuffer) {
+        target.draw(mesh.buffer, begin, vertexCount, states);
+    } else {
+        target.draw(mesh.vertices.data() + begin, vertexCount, sf::PrimitiveType::Lines, states);
+    }
+    stats.vertices += static_cast<int>(vertexCount);
+    stats.drawCalls++;
+}
+
+void Renderer::drawTrail(sf::RenderTarget& target, const TrailBuffer& trail) {
+    if (trail.size() < 2) return;
+
+    if (!trailShaderTried) {
+        trailShaderTried = true;
+        trailShaderLoaded = sf::Shader::isAvailable() &&
+                            trailShader.loadFromMemory(TRAIL_VERTEX_SHADER, sf::Shader::Type::Vertex);
+    }
+    TrailMesh& mesh = updateTrailMesh(trail);
+
+    // Fading trails are colored by age over the whole capacity; closed curves by
+    // position from their first point
+    std::uint64_t newest = trail.newestSequence();
+    std::uint64_t oldest = newest + 1 - trail.size();
+    bool fade = !trail.isClosed();
+    std::uint64_t base = fade ? newest + TRAIL_SEQUENCE_WRAP - trail.capacity() : oldest;
+    float span = static_cast<float>(fade ? trail.capacity() : std::max<std::uint64_t>(newest - oldest, 1));
 
-            sf::Vertex line[2];
-            line[0].position = trail[i - 1].toSFML();
-            line[0].color = sf::Color(color.r, color.g, color.b, alpha);
-            line[1].position = trail[i].toSFML();
-            line[1].color = sf::Color(color.r, color.g, color.b, alpha);
-            window.draw(line, 2, sf::PrimitiveType::Lines);
+    sf::RenderStates states;
+    if (trailShaderLoaded) {
+        trailShader.setUniform("base", static_cast<float>(base % TRAIL_SEQUENCE_WRAP));
+        trailShader.setUniform("span", span);
+        trailShader.setUniform("wrap", static_cast<float>(TRAIL_SEQUENCE_WRAP));
+        trailShader.setUniform("fade", fade ? 1.f : 0.f);
+        states.shader = &trailShader;
+    } else {
+        // No shaders: recolor every vertex on the CPU
+        for (sf::Vertex& vertex : mesh.vertices) {
+            float position = static_cast<float>((static_cast<std::uint64_t>(vertex.texCoords.x) +
+                                                 TRAIL_SEQUENCE_WRAP - base % TRAIL_SEQUENCE_WRAP) % TRAIL_SEQUENCE_WRAP);
+            float t = std::min(position / span, 1.0f);
+            sf::Color color = t < 0.5f
+                ? lerpColor(sf::Color(255, 110, 199), sf::Color(0, 240, 255), t * 2.0f)   // Pink to Cyan
+                : lerpColor(sf::Color(0, 240, 255), sf::Color(185, 103, 255), (t - 0.5f) * 2.0f);  // Cyan to Purple
+            color.a = fade ? static_cast<std::uint8_t>(std::min(t * t * 255 * 1.6f, 255.f)) : 255;
+            vertex.color = color;
         }
     }
+
+    // Used chunks run from the oldest forward and wrap around the ring at most once
+    int first = trail.oldestChunk();
+    int used = trail.usedChunkCount();
+    int untilEnd = std::min(used, trail.chunkCount() - first);
+    submitTrailChunks(target, trail, mesh, first, untilEnd, states);
+    submitTrailChunks(target, trail, mesh, 0, used - untilEnd, states);
+
+    // A complete closed curve also joins its ends
+    if (trail.isClosed() && trail.isComplete()) {
+        sf::Color endColor(185, 103, 255);  // Purple
+        trailVertices.clear();
+        trailVertices.append(sf::Vertex{trail[trail.size() - 1].toSFML(), endColor});
+        trailVertices.append(sf::Vertex{trail[0].toSFML(), sf::Color(255, 110, 199)});
+        submit(target, trailVertices);
+    }
 }
 
-void Renderer::drawEpicycles(sf::RenderWindow& window, const std::vector<Epicycle>& epicycles) {
-    // Draw all epicycles
-    for (const auto& epic : epicycles) {
+float Renderer::pixelScale(const sf::RenderTarget& target) const {
+    const sf::View& view = target.getView();
+    return target.getSize().x * view.getViewport().size.x / view.getSize().x;
+}
+
+void Renderer::appendEpicycles(const Epicycle* epicycles, int count, float scale) {
+    // All circles go into one line list and all center dots into one triangle list;
+    // sub-pixel circles collapse to a single point
+    for (int i = 0; i < count; i++) {
+        const Epicycle& epic = epicycles[i];
+
         // Make epicycles more subtle with transparency
         sf::Color subtleColor = epic.color;
         subtleColor.a = 150;  // Add transparency
 
-        // Draw the circle
-        sf::CircleShape circle(epic.radius);
-        circle.setOrigin({epic.radius, epic.radius});
-        circle.setPosition(epic.center.toSFML());
-        circle.setFillColor(sf::Color::Transparent);
-        circle.setOutlineThickness(1.5f);  // Subtle outline
-        circle.setOutlineColor(subtleColor);
-        window.draw(circle);
+        sf::Vector2f center = epic.center.toSFML();
+        float pixelRadius = epic.radius * scale;
+        if (pixelRadius < cullRadius) {
+            pointVertices.append(sf::Vertex{center, subtleColor});
+            stats.circlesCulled++;
+            continue;
+        }
 
-        // Draw center dot (also subtle)
-        sf::CircleShape dot(2.f);  // Slightly smaller
-        dot.setOrigin({2.f, 2.f});
-        dot.setPosition(epic.center.toSFML());
-        dot.setFillColor(subtleColor);
-        window.draw(dot);
+        appendCircle(circleVertices, circleForRadius(pixelRadius), center, epic.radius, subtleColor);
+        appendDisc(dotVertices, unitDot, center, 2.f, subtleColor);
+        stats.circlesDrawn++;
     }
 }
 
-void Renderer::drawGlow(sf::RenderWindow& window, const Point2D& position) {
+void Renderer::drawEpicycles(sf::RenderTarget& target, const std::vector<Epicycle>& epicycles) {
+    circleVertices.clear();
+    dotVertices.clear();
+    pointVertices.clear();
+    appendEpicycles(epicycles.data(), static_cast<int>(epicycles.size()), pixelScale(target));
+
+    submit(target, circleVertices);
+    submit(target, dotVertices);
+    submit(target, pointVertices);
+}
+
+void Renderer::drawArms(sf::RenderTarget& target, const std::vector<Epicycle>& epicycles, const Point2D& tip) {
+    if (epicycles.empty()) return;
+
+    // Arms run center to center and end at the pen, as a single strip
+    armVertices.resize(epicycles.size() + 1);
+    for (size_t i = 0; i < epicycles.size(); i++) {
+        // Make connecting lines subtle
+        sf::Color subtleColor = epicycles[i].color;
+        subtleColor.a = 150;  // Add transparency
+
+        armVertices[i].position = epicycles[i].center.toSFML();
+        armVertices[i].color = subtleColor;
+    }
+    armVertices[epicycles.size()].position = tip.toSFML();
+    armVertices[epicycles.size()].color = armVertices[epicycles.size() - 1].color;
+    submit(target, armVertices);
+}
+
+void Renderer::drawGlow(sf::RenderTarget& target, const Point2D& position) {
+    glowVertices.clear();
+    appendGlow(position.toSFML());
+    submit(target, glowVertices, sf::BlendAdd);  // Additive blending for glow
+}
+
+void Renderer::drawEpicycleSets(sf::RenderTarget& target, const std::vector<EpicycleSet>& sets, bool showEpicycles) {
+    armLineVertices.clear();
+    circleVertices.clear();
+    dotVertices.clear();
+    pointVertices.clear();
+    glowVertices.clear();
+
+    float scale = pixelScale(target);
+    for (const EpicycleSet& set : sets) {
+        if (set.count <= 0) continue;
+        appendGlow(set.tip.toSFML());
+        if (!showEpicycles) continue;
+
+        // Separate chains, so arms are a line list rather than one strip
+        for (int i = 0; i < set.count; i++) {
+            sf::Color subtleColor = set.epicycles[i].color;
+            subtleColor.a = 150;
+            Point2D end = i + 1 < set.count ? set.epicycles[i + 1].center : set.tip;
+            armLineVertices.append(sf::Vertex{set.epicycles[i].center.toSFML(), subtleColor});
+            armLineVertices.append(sf::Vertex{end.toSFML(), subtleColor});
+        }
+        appendEpicycles(set.epicycles, set.count, scale);
+    }
+
+    submit(target, armLineVertices);
+    submit(target, circleVertices);
+    submit(target, dotVertices);
+    submit(target, pointVertices);
+    submit(target, glowVertices, sf::BlendAdd);
+}
+
+void Renderer::appendGlow(sf::Vector2f center) {
     // Multi-layer glow effect
     for (int i = 5; i >= 1; i--) {
         float radius = i * 3.0f;
         int alpha = 50 / i;  // Fade outward
-
-        sf::CircleShape glow(radius);
-        glow.setOrigin({radius, radius});
-        glow.setPosition(position.toSFML());
-        glow.setFillColor(sf::Color(0, 240, 255, alpha));  // Cyan glow
-        window.draw(glow, sf::BlendAdd);  // Additive blending for glow
+        appendDisc(glowVertices, unitCircle, center, radius, sf::Color(0, 240, 255, alpha));  // Cyan glow
     }
 
     // Bright center point
-    sf::CircleShape centerPoint(2.f);
-    centerPoint.setOrigin({2.f, 2.f});
-    centerPoint.setPosition(position.toSFML());
-    centerPoint.setFillColor(sf::Color(255, 255, 255));
-    window.draw(centerPoint, sf::BlendAdd);
+    appendDisc(glowVertices, unitDot, center, 2.f, sf::Color(255, 255, 255));
 }
 
-void Renderer::drawUserPath(sf::RenderWindow& window, const std::vector<Point2D>& path) {
+void Renderer::drawUserPath(sf::RenderTarget& target, const std::vector<Point2D>& path) {
     if (path.size() < 2) return;
 
     // Draw the path the user is drawing in white
+    pathVertices.resize(path.size());
+    for (size_t i = 0; i < path.size(); i++) {
+        pathVertices[i].position = path[i].toSFML();
+        pathVertices[i].color = sf::Color(255, 255, 255, 200);  // Bright white, slightly transparent
+    }
+    submit(target, pathVertices);
+
+    // Draw dots along the stroke. Samples are only a pixel or so apart, so a dot
+    // at each would merge into a solid band; space them out, ending on the last.
+    dotVertices.clear();
+    Point2D lastDot = path[0];
+    appendDisc(dotVertices, unitDot, lastDot.toSFML(), 2.f, sf::Color(255, 255, 255));
     for (size_t i = 1; i < path.size(); i++) {
-        sf::Vertex line[2];
-        line[0].position = path[i - 1].toSFML();
-        line[0].color = sf::Color(255, 255, 255, 200);  // Bright white, slightly transparent
-        line[1].position = path[i].toSFML();
-        line[1].color = sf::Color(255, 255, 255, 200);
-        window.draw(line, 2, sf::PrimitiveType::Lines);
-    }
-
-    // Draw dots at each point
-    for (const auto& point : path) {
-        sf::CircleShape dot(2.f);
-        dot.setOrigin({2.f, 2.f});
-        dot.setPosition(point.toSFML());
-        dot.setFillColor(sf::Color(255, 255, 255));
-        window.draw(dot);
+        float dx = path[i].x - lastDot.x;
+        float dy = path[i].y - lastDot.y;
+        if (dx * dx + dy * dy < USER_PATH_DOT_SPACING * USER_PATH_DOT_SPACING && i + 1 < path.size()) continue;
+        lastDot = path[i];
+        appendDisc(dotVertices, unitDot, lastDot.toSFML(), 2.f, sf::Color(255, 255, 255));
+    }
+    submit(target, dotVertices);
+}
+
+void Renderer::drawOutline(sf::RenderTarget& target, const std::vector<Point2D>& outline, Point2D offset) {
+    if (outline.size() < 2) return;
+
+    // Faint closed curve showing the full reconstruction
+    outlineVertices.resize(outline.size() + 1);
+    for (size_t i = 0; i <= outline.size(); i++) {
+        const Point2D& p = outline[i % outline.size()];
+        outlineVertices[i].position = sf::Vector2f(p.x + offset.x, p.y + offset.y);
+        outlineVertices[i].color = sf::Color(255, 255, 255, 60);
     }
+    submit(target, outlineVertices);
 }
@@ -0,0 +1,113 @@
+#include "Scene.h"
+#include <algorithm>
+
+namespace {
+
+const int SCENE_TRAIL_CAPACITY = 512;
+const float SCENE_TRAIL_SPACING = 2.f;   // Pixels
+const float SCENE_TRAIL_TURN = 0.15f;    // Radians
+
+} // namespace
+
+template <typename Precision>
+BasicScene<Precision>::BasicScene(int threads) : pool(threads) {
+}
+
+template <typename Precision>
+int BasicScene<Precision>::addShape(const std::vector<Point2D>& path, Point2D origin, double speed, int epicycles) {
+    std::unique_ptr<Shape> shape = std::make_unique<Shape>(std::max(epicycles, 1), SCENE_TRAIL_CAPACITY);
+    shape->origin = origin;
+    shape->speed = speed;
+    shape->trail.setSpacing(SCENE_TRAIL_SPACING, SCENE_TRAIL_TURN);
+
+    // Shapes already run in parallel, so each transform stays on its own thread
+    shape->engine.setThreadCount(1);
+    shape->engine.setNumEpicycles(shape->maxEpicycles);
+    shape->engine.setTopK(shape->maxEpicycles);
+    shape->path = path;
+    shape->pending = true;
+
+    shapes.push_back(std::move(shape));
+    return size() - 1;
+}
+
+template <typename Precision>
+int BasicScene<Precision>::addShape(const PresetShape& preset, Point2D origin, double speed, int epicycles, float size) {
+    int index = addShape(std::vector<Point2D>(), origin, speed, epicycles);
+    shapes[index]->preset = &preset;
+    shapes[index]->presetScale = preset.extent > 0.f ? size / preset.extent : 1.f;
+    return index;
+}
+
+template <typename Precision>
+void BasicScene<Precision>::setPath(int index, const std::vector<Point2D>& path) {
+    shapes[index]->path = path;
+    shapes[index]->preset = nullptr;
+    shapes[index]->pending = true;
+}
+
+template <typename Precision>
+void BasicScene<Precision>::update(double dt, double speed) {
+    // One shape per task: an engine's evaluation caches are not shared between threads
+    pool.parallelFor(size(), 1, [this, dt, speed](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            Shape& shape = *shapes[i];
+            BasicFourierEngine<Precision>& engine = shape.engine;
+            if (shape.pending) {
+                if (shape.preset) {
+                    engine.loadPreset(*shape.preset, shape.presetScale);
+                } else {
+                    engine.computeDFT(shape.path);
+                }
+                engine.resetClock();
+                shape.pending = false;
+                shape.ticks.stale = true;
+                shape.trail.clear();
+            } else {
+                engine.accumulate(dt);
+            }
+
+            while (engine.step(speed * shape.speed)) {
+                engine.evaluateTick(shape.origin, shape.ticks);
+                shape.trail.add(shape.ticks.latestTip(), engine.getTime());
+            }
+            if (shape.ticks.stale) engine.evaluateTick(shape.origin, shape.ticks);
+
+            shape.tip = engine.interpolateTicks(shape.ticks, shape.epicycles.data(), shape.visibleEpicycles);
+            Renderer::colorEpicycles(shape.epicycles.data(), shape.visibleEpicycles);
+        }
+    });
+}
+
+template <typename Precision>
+void BasicScene<Precision>::reset() {
+    for (std::unique_ptr<Shape>& shape : shapes) {
+        shape->engine.resetClock();
+        shape->ticks.stale = true;
+        shape->trail.clear();
+    }
+}
+
+template <typename Precision>
+void BasicScene<Precision>::draw(sf::RenderTarget& target, Renderer& renderer, bool showEpicycles, bool showTrails) {
+    // One draw per trail, unlike the epicycles below. Each trail keeps its own
+    // vertex buffer on the GPU and uploads only the chunks that changed, and its
+    // fade comes from per-trail shader uniforms (newest sequence, span). A merged
+    // mesh would have to bake every vertex's age into its color and re-upload all
+    // of it each frame, which costs more than the extra draw calls for the few
+    // dozen shapes a scene holds.
+    if (showTrails) {
+        for (const std::unique_ptr<Shape>& shape : shapes) {
+            renderer.drawTrail(target, shape->trail);
+        }
+    }
+
+    sets.clear();
+    for (const std::unique_ptr<Shape>& shape : shapes) {
+        sets.push_back({shape->epicycles.data(), shape->visibleEpicycles, shape->tip});
+    }
+    renderer.drawEpicycleSets(target, sets, showEpicycles);
+}
+
+template class BasicScene<SinglePrecision>;
+template class BasicScene<DoublePrecision>;
@@ -0,0 +1,151 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+// Chunks each worker's ring holds; chunks dealt to a full ring run on the caller
+const int QUEUE_CAPACITY = 256;
+
+} // namespace
+
+bool ThreadPool::WorkQueue::pushBack(const Task& task) {
+    int capacity = static_cast<int>(tasks.size());
+    if (count == capacity) return false;
+    tasks[(head + count) % capacity] = task;
+    count++;
+    return true;
+}
+
+bool ThreadPool::WorkQueue::popBack(Task& task) {
+    if (count == 0) return false;
+    count--;
+    task = tasks[(head + count) % static_cast<int>(tasks.size())];
+    return true;
+}
+
+bool ThreadPool::WorkQueue::popFront(Task& task) {
+    if (count == 0) return false;
+    task = tasks[head];
+    head = (head + 1) % static_cast<int>(tasks.size());
+    count--;
+    return true;
+}
+
+ThreadPool::ThreadPool(int threads) : queued(0), nextQueue(0), stopping(false) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+
+    for (int i = 0; i < threads - 1; i++) {
+        queues.push_back(std::make_unique<WorkQueue>(QUEUE_CAPACITY));
+    }
+    for (int i = 0; i < threads - 1; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::run(int count, int grain, const Body& body) {
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+    int chunks = (count + grain - 1) / grain;
+
+    // Nothing to share: run inline
+    if (workers.empty() || chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    // Deal chunks across the worker queues; the starting queue rotates so
+    // concurrent callers do not all pile onto the first worker. A chunk whose
+    // queue is full runs right here instead, once the workers have been woken.
+    std::atomic<int> remaining(chunks);
+    int queueCount = static_cast<int>(queues.size());
+    int first = static_cast<int>(nextQueue.fetch_add(1) % queueCount);
+    bool unannounced = false;  // Chunks queued since the last wake-up
+    auto announce = [&]() {
+        if (!unannounced) return;
+        unannounced = false;
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+        wake.notify_all();
+    };
+    for (int c = 0; c < chunks; c++) {
+        Task task{&body, c * grain, std::min(count, (c + 1) * grain), &remaining};
+        WorkQueue& queue = *queues[(first + c) % queueCount];
+        bool pushed;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            pushed = queue.pushBack(task);
+            if (pushed) queued.fetch_add(1);
+        }
+        if (pushed) {
+            unannounced = true;
+        } else {
+            announce();
+            run(task);
+        }
+    }
+    announce();
+
+    // Help out until every chunk of this loop has finished
+    Task task;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (steal(-1, task)) {
+            run(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool ThreadPool::popLocal(int index, Task& task) {
+    WorkQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.popBack(task)) return false;
+    queued.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::steal(int thief, Task& task) {
+    int queueCount = static_cast<int>(queues.size());
+    int start = thief >= 0 ? thief + 1 : 0;
+    for (int i = 0; i < queueCount; i++) {
+        int victim = (start + i) % queueCount;
+        if (victim == thief) continue;
+
+        WorkQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.popFront(task)) continue;
+        queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(const Task& task) {
+    (*task.body)(task.begin, task.end);
+    task.remaining->fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::workerLoop(int index) {
+    Task task;
+    for (;;) {
+        if (popLocal(index, task) || steal(index, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this]() { return stopping || queued.load() > 0; });
+        if (stopping) return;
+    }
+}
@@ -0,0 +1,120 @@
+#include "TrailBuffer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+std::atomic<std::uint64_t> nextTrailId(1);
+
+} // namespace
+
+TrailBuffer::TrailBuffer(int capacity)
+    : headChunk(0), usedChunks(0), newestFill(0), nextSequence(0), id(nextTrailId++),
+      minDistance(0.f), maxTurn(0.f), closed(false), complete(false),
+      startTime(0.0), hasDirection(false) {
+    int chunks = std::max(2, (capacity + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    points.resize(chunks * CHUNK_SIZE);
+    sequences.assign(chunks, 0);
+    versions.assign(chunks, 0);
+}
+
+void TrailBuffer::setSpacing(float distance, float turn) {
+    minDistance = std::max(distance, 0.f);
+    maxTurn = std::max(turn, 0.f);
+}
+
+void TrailBuffer::setClosed(bool isClosed) {
+    closed = isClosed;
+    complete = false;
+}
+
+bool TrailBuffer::add(const Point2D& point, double t) {
+    if (complete) return false;
+    if (empty()) {
+        push(point);
+        startTime = t;
+        hasDirection = false;
+        return true;
+    }
+
+    // One period recorded: the curve repeats from here on
+    if (closed && t - startTime >= 1.0) {
+        complete = true;
+        return false;
+    }
+
+    const Point2D& last = (*this)[size() - 1];
+    float dx = point.x - last.x;
+    float dy = point.y - last.y;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance == 0.f) return false;
+
+    bool keep = distance >= minDistance;
+    if (!keep && hasDirection && maxTurn > 0.f && distance >= 0.25f * minDistance) {
+        float cross = direction.x * dy - direction.y * dx;
+        float dot = direction.x * dx + direction.y * dy;
+        keep = std::atan2(std::fabs(cross), dot) >= maxTurn;
+    }
+    if (!keep) return false;
+
+    push(point);
+    direction = Point2D(dx / distance, dy / distance);
+    hasDirection = true;
+    return true;
+}
+
+void TrailBuffer::push(const Point2D& point) {
+    int chunks = chunkCount();
+    if (usedChunks == 0) {
+        usedChunks = 1;
+        newestFill = 0;
+    } else if (newestFill == CHUNK_SIZE) {
+        if (usedChunks == chunks) {
+            headChunk = (headChunk + 1) % chunks;
+            usedChunks--;
+        }
+        usedChunks++;
+        newestFill = 0;
+    }
+
+    int chunk = (headChunk + usedChunks - 1) % chunks;
+    if (newestFill == 0) {
+        sequences[chunk] = nextSequence;
+        // The previous chunk's geometry runs up to this point
+        if (usedChunks > 1) versions[(chunk + chunks - 1) % chunks]++;
+    }
+    points[chunk * CHUNK_SIZE + newestFill] = point;
+    newestFill++;
+    nextSequence++;
+    versions[chunk]++;
+}
+
+void TrailBuffer::clear() {
+    headChunk = 0;
+    usedChunks = 0;
+    newestFill = 0;
+    complete = false;
+    hasDirection = false;
+}
+
+int TrailBuffer::size() const {
+    return usedChunks == 0 ? 0 : (usedChunks - 1) * CHUNK_SIZE + newestFill;
+}
+
+const Point2D& TrailBuffer::operator[](int i) const {
+    int chunk = (headChunk + i / CHUNK_SIZE) % chunkCount();
+    return points[chunk * CHUNK_SIZE + i % CHUNK_SIZE];
+}
+
+int TrailBuffer::chunkSize(int chunk) const {
+    int position = (chunk - headChunk + chunkCount()) % chunkCount();
+    if (position >= usedChunks) return 0;
+    return position == usedChunks - 1 ? newestFill : CHUNK_SIZE;
+}
+
+int TrailBuffer::nextChunk(int chunk) const {
+    int position = (chunk - headChunk + chunkCount()) % chunkCount();
+    if (position + 1 >= usedChunks) return -1;
+    return (chunk + 1) % chunkCount();
+}
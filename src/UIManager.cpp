@@ -1,7 +1,14 @@
 #include "UIManager.h"
+#include <cstdio>
 #include <iostream>
 
-UIManager::UIManager() : fontLoaded(false) {
+// Overlay numbers update every this many frames (4 times a second at 60 FPS)
+const int PROFILER_REFRESH_FRAMES = 15;
+
+UIManager::UIManager() : fontLoaded(false), profilerFrames(0) {
+    panel.setFillColor(sf::Color(20, 20, 40, 180));  // Dark blue-ish, semi-transparent
+    panel.setOutlineThickness(1.f);
+    panel.setOutlineColor(sf::Color(100, 100, 150, 100));  // Subtle border
 }
 
 bool UIManager::loadFont(const std::string& fontPath) {
@@ -14,20 +21,54 @@ bool UIManager::loadFont(const std::string& fontPath) {
     return false;
 }
 
-void UIManager::drawPanel(sf::RenderWindow& window, float x, float y, float width, float height) {
-    sf::RectangleShape panel({width, height});
+void UIManager::drawPanel(sf::RenderTarget& target, float x, float y, float width, float height) {
+    panel.setSize({width, height});
     panel.setPosition({x, y});
-    panel.setFillColor(sf::Color(20, 20, 40, 180));  // Dark blue-ish, semi-transparent
-    panel.setOutlineThickness(1.f);
-    panel.setOutlineColor(sf::Color(100, 100, 150, 100));  // Subtle border
-    window.draw(panel);
+    target.draw(panel);
 }
 
-void UIManager::drawText(sf::RenderWindow& window, const std::string& text, float x, float y, unsigned int size) {
+void UIManager::drawText(sf::RenderTarget& target, const std::string& text, float x, float y, unsigned int size) {
     if (!fontLoaded) return;
 
+    // Reuse the label drawn at this spot last frame; only touch it if the text changed
+    for (auto& slot : textSlots) {
+        if (slot.x == x && slot.y == y && slot.size == size) {
+            if (slot.text != text) {
+                slot.text = text;
+                slot.label.setString(text);
+            }
+            target.draw(slot.label);
+            return;
+        }
+    }
+
     sf::Text textObj(font, text, size);
     textObj.setPosition({x, y});
     textObj.setFillColor(sf::Color(255, 255, 255, 200));  // White, slightly transparent
-    window.draw(textObj);
+    textSlots.push_back({x, y, size, text, textObj});
+    target.draw(textSlots.back().label);
+}
+
+void UIManager::drawProfiler(sf::RenderTarget& target, const Profiler& profiler, float x, float y) {
+    const int zones = static_cast<int>(ProfileZone::Count);
+    const float lineHeight = 16.f;
+
+    if (profilerLines.empty() || ++profilerFrames >= PROFILER_REFRESH_FRAMES) {
+        profilerFrames = 0;
+        profilerLines.resize(zones);
+        char line[96];
+        for (int i = 0; i < zones; i++) {
+            ProfileZone zone = static_cast<ProfileZone>(i);
+            Profiler::ZoneStats stats = profiler.getStats(zone);
+            std::snprintf(line, sizeof(line), "%-10s %6.2f %6.2f %6.2f",
+                          Profiler::zoneName(zone), stats.minMs, stats.avgMs, stats.p99Ms);
+            profilerLines[i] = line;
+        }
+    }
+
+    drawPanel(target, x, y, 260, 30 + zones * lineHeight);
+    drawText(target, "PROFILER (ms)   min    avg    p99", x + 10, y + 5, 12);
+    for (int i = 0; i < zones; i++) {
+        drawText(target, profilerLines[i], x + 10, y + 24 + i * lineHeight, 12);
+    }
 }
@@ -1,38 +1,176 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 #include "Types.h"
 #include "FourierEngine.h"
 #include "PathData.h"
+#include "PathLoader.h"
+#include "Presets.h"
+#include "CoefficientCache.h"
+#include "Scene.h"
 #include "Renderer.h"
 #include "InputHandler.h"
 #include "UIManager.h"
+#include "TrailBuffer.h"
+#include "AllocationCounter.h"
+#include "FrameWriter.h"
+#include "Profiler.h"
+
+// Command-line options
+struct Options {
+    bool headless = false;       // Render offscreen and export frames instead of opening a window
+    unsigned int width = 1280;
+    unsigned int height = 720;
+    int frames = 600;            // Headless: number of frames to render
+    float timeStep = 1.f / 60.f; // Headless: seconds of animation per frame
+    std::string outputDir = "frames";
+    int shape = 1;               // Preset 1-5 to start with
+    float speed = 0.3f;
+    int epicycles = 100;
+    int threads = 0;             // Threads for long transforms (0: all cores)
+    std::string traceFile;       // Chrome trace-event JSON of every frame, written on exit
+    std::string loadFile;        // SVG, CSV or binary point file to start with
+    int points = 0;              // Points to resample a loaded file to (0: at least 1024)
+    std::string cacheDir;        // Coefficient cache directory (empty: no cache)
+    int cacheSizeMB = 256;       // Cache size limit
+    float tolerance = 1.0f;      // Largest deviation (pixels) allowed when simplifying strokes
+    int sceneShapes = 0;         // Drawings in scene mode (0: one interactive drawing)
+    double tickRate = 240.0;     // Simulation ticks per second
+    std::string precision;       // "float" or "double" (empty: float in a window, double headless)
+};
+
+void printUsage() {
+    std::cout << "Usage: fourier-visualizer [options]\n"
+              << "  --headless          Render offscreen to numbered PNGs (no window, no frame limiter)\n"
+              << "  --size WxH          Render resolution (default 1280x720)\n"
+              << "  --frames N          Headless: frames to render (default 600)\n"
+              << "  --dt SECONDS        Headless: time step per frame (default 1/60)\n"
+              << "  --output DIR        Headless: output directory (default ./frames)\n"
+              << "  --shape 1-5         Starting shape: circle, square, star, heart, infinity\n"
+              << "  --speed X           Animation speed multiplier (default 0.3)\n"
+              << "  --epicycles N       Epicycles to show (default 100)\n"
+              << "  --threads N         Threads for long transforms (default: all cores)\n"
+              << "  --trace FILE        Write per-stage frame timings as Chrome trace JSON on exit\n"
+              << "  --load FILE         Start with an outline from an SVG, CSV or binary point file\n"
+              << "  --points N          Resample a loaded outline to N points\n"
+              << "  --cache-dir DIR     Keep computed coefficients in DIR and reuse them\n"
+              << "  --cache-size MB     Coefficient cache size limit (default 256)\n"
+              << "  --tolerance PX      How far a simplified stroke may stray (default 1)\n"
+              << "  --scene N           Animate a grid of N independent drawings\n"
+              << "  --tick-rate HZ      Simulation ticks per second (default 240)\n"
+              << "  --precision P       Evaluate epicycles in float or double\n"
+              << "                      (default: float in a window, double headless)" << std::endl;
+}
+
+// Returns false if the program should exit (help requested or bad arguments)
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--size" && hasValue) {
+            std::string value = argv[++i];
+            size_t x = value.find('x');
+            if (x == std::string::npos) {
+                std::cerr << "Bad --size '" << value << "', expected WxH" << std::endl;
+                return false;
+            }
+            options.width = static_cast<unsigned int>(std::atoi(value.substr(0, x).c_str()));
+            options.height = static_cast<unsigned int>(std::atoi(value.substr(x + 1).c_str()));
+        } else if (arg == "--frames" && hasValue) {
+            options.frames = std::atoi(argv[++i]);
+        } else if (arg == "--dt" && hasValue) {
+            options.timeStep = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--output" && hasValue) {
+            options.outputDir = argv[++i];
+        } else if (arg == "--shape" && hasValue) {
+            options.shape = std::atoi(argv[++i]);
+        } else if (arg == "--speed" && hasValue) {
+            options.speed = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--epicycles" && hasValue) {
+            options.epicycles = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--trace" && hasValue) {
+            options.traceFile = argv[++i];
+        } else if (arg == "--load" && hasValue) {
+            options.loadFile = argv[++i];
+        } else if (arg == "--points" && hasValue) {
+            options.points = std::atoi(argv[++i]);
+        } else if (arg == "--cache-dir" && hasValue) {
+            options.cacheDir = argv[++i];
+        } else if (arg == "--cache-size" && hasValue) {
+            options.cacheSizeMB = std::atoi(argv[++i]);
+        } else if (arg == "--tolerance" && hasValue) {
+            options.tolerance = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--scene" && hasValue) {
+            options.sceneShapes = std::atoi(argv[++i]);
+        } else if (arg == "--tick-rate" && hasValue) {
+            options.tickRate = std::atof(argv[++i]);
+        } else if (arg == "--precision" && hasValue) {
+            options.precision = argv[++i];
+            if (options.precision != "float" && options.precision != "double") {
+                std::cerr << "Bad --precision '" << options.precision << "', expected float or double" << std::endl;
+                return false;
+            }
+        } else {
+            if (arg != "--help" && arg != "-h") std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage();
+            return false;
+        }
+    }
 
-// Helper function for color interpolation
-sf::Color lerpColor(sf::Color a, sf::Color b, float t) {
-    return sf::Color(
-        static_cast<uint8_t>(a.r + (b.r - a.r) * t),
-        static_cast<uint8_t>(a.g + (b.g - a.g) * t),
-        static_cast<uint8_t>(a.b + (b.b - a.b) * t)
-    );
+    if (options.width == 0 || options.height == 0 || options.frames < 0 || options.timeStep <= 0.f) {
+        std::cerr << "Invalid size, frame count or time step" << std::endl;
+        return false;
+    }
+    return true;
 }
 
-int main() {
-    // Create window
-    sf::RenderWindow window(sf::VideoMode({1280, 720}), "Fourier Series Visualizer");
-    window.setFramerateLimit(60);
-    window.setVerticalSyncEnabled(true);
+// Run the visualizer with epicycles evaluated in Precision's scalar type
+template <typename Precision>
+int runVisualizer(const Options& options) {
+    // Create the render target: a window, or an offscreen texture in headless mode
+    std::optional<sf::RenderWindow> window;
+    std::optional<sf::RenderTexture> canvas;
+    std::optional<FrameWriter> frameWriter;
+    sf::RenderTarget* target = nullptr;
+
+    if (options.headless) {
+        canvas.emplace();
+        if (!canvas->resize({options.width, options.height})) {
+            std::cerr << "Failed to create " << options.width << "x" << options.height
+                      << " offscreen target" << std::endl;
+            return 1;
+        }
+        target = &*canvas;
+        frameWriter.emplace(options.outputDir);
+        std::cout << "Fourier Visualizer - rendering " << options.frames << " frames to "
+                  << options.outputDir << std::endl;
+    } else {
+        window.emplace(sf::VideoMode({options.width, options.height}), "Fourier Series Visualizer");
+        window->setFramerateLimit(60);
+        window->setVerticalSyncEnabled(true);
+        target = &*window;
+        std::cout << "Fourier Visualizer - Window created!" << std::endl;
+    }
 
-    std::cout << "Fourier Visualizer - Window created!" << std::endl;
+    const float width = static_cast<float>(options.width);
+    const float height = static_cast<float>(options.height);
 
     // Animation variables
     sf::Clock clock;
-    float time = 0.f;
-    Point2D screenCenter(640.f, 360.f);
+    Point2D screenCenter(width / 2.f, height / 2.f);
 
     // Create Fourier Engine, Renderer, Input Handler, and UI Manager
-    FourierEngine fourierEngine;
+    BasicFourierEngine<Precision> fourierEngine;
     Renderer renderer;
     InputHandler inputHandler;
     UIManager uiManager;
@@ -42,102 +180,182 @@ int main() {
         std::cout << "Warning: UI text will not be displayed" << std::endl;
     }
 
-    // Start with circle
-    std::vector<Point2D> path = PathData::createCircle(100, 120.f);
-    fourierEngine.computeDFT(path);
+    // Current shape name
+    std::string currentShapeName;
+
+    // Start with a loaded outline, or the requested preset (circle by default)
+    std::vector<Point2D> path;
+    fourierEngine.setThreadCount(options.threads);
+    fourierEngine.setTickRate(options.tickRate);
+    if (!options.cacheDir.empty()) {
+        std::uint64_t cacheBytes = static_cast<std::uint64_t>(std::max(options.cacheSizeMB, 0)) << 20;
+        fourierEngine.setCache(std::make_shared<CoefficientCache>(options.cacheDir, cacheBytes));
+    }
+    if (!options.loadFile.empty()) {
+        LoadedPath loaded;
+        if (!PathLoader::load(options.loadFile, loaded)) {
+            return 1;
+        }
+
+        // Resample straight from the loaded points, then center and fit to the view.
+        // In a window, long outlines are transformed in the background, coarse
+        // preview first; headless export waits for the exact spectrum so every run
+        // writes the same frames.
+        int points = options.points > 0 ? options.points : std::max<int>(static_cast<int>(loaded.size()), 1024);
+        path = PathData::resamplePath(loaded.data(), loaded.size(), points);
+        PathData::centerAndFitPath(path, 0.8f * std::min(width, height));
+        currentShapeName = options.loadFile.substr(options.loadFile.find_last_of("/\\") + 1);
+        std::cout << "Loaded " << loaded.size() << " points from " << options.loadFile << std::endl;
+        if (options.headless) {
+            fourierEngine.computeDFT(std::move(path));
+        } else {
+            fourierEngine.submitPath(std::move(path));
+        }
+    } else {
+        // Built-in shapes come with their spectra, so startup does no transform
+        const PresetShape& preset = Presets::get(options.shape);
+        fourierEngine.loadPreset(preset);
+        currentShapeName = preset.name;
+        std::cout << "Press 1-5 to switch shapes" << std::endl;
+    }
 
-    std::cout << "DFT computed! Press 1-5 to switch shapes" << std::endl;
+    // Scene mode: a grid of independent drawings cycling through the presets,
+    // each at its own speed, evaluated in parallel every frame
+    std::unique_ptr<BasicScene<Precision>> scene;
+    if (options.sceneShapes > 0) {
+        scene = std::make_unique<BasicScene<Precision>>(options.threads);
+        int shapes = options.sceneShapes;
+        int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(shapes * width / height))));
+        int rows = (shapes + columns - 1) / columns;
+        float cellWidth = width / columns;
+        float cellHeight = height / rows;
+        int sceneEpicycles = std::max(1, std::min(options.epicycles, 200));
+        for (int i = 0; i < shapes; i++) {
+            Point2D cellCenter((i % columns + 0.5f) * cellWidth, (i / columns + 0.5f) * cellHeight);
+            scene->addShape(Presets::get(i % Presets::COUNT + 1), cellCenter, 0.6 + 0.2 * (i % 5), sceneEpicycles,
+                            0.7f * std::min(cellWidth, cellHeight));
+        }
+        currentShapeName = "Scene: " + std::to_string(shapes) + " drawings";
+    }
 
-    // Trail for the path
-    std::vector<Point2D> trail;
-    const int maxTrailLength = 300;
+    // Trails for the pen (chunked rings, allocated once). A point is kept every
+    // couple of pixels or on a sharp turn, so trail length doesn't depend on the
+    // frame rate. The loop trail records one whole period of the curve instead.
+    const float trailSpacing = 2.f;   // Pixels
+    const float trailTurn = 0.15f;    // Radians
+    TrailBuffer trail(640);
+    trail.setSpacing(trailSpacing, trailTurn);
+    TrailBuffer loopTrail(16384);
+    loopTrail.setSpacing(trailSpacing, trailTurn);
+    loopTrail.setClosed(true);
+    bool showLoop = false;
+
+    // Epicycle output buffer, sized for the largest count the UI allows
+    const int maxEpicycles = 200;
+    std::vector<Epicycle> epicycles;
+    epicycles.reserve(maxEpicycles);
+    EpicycleTicks ticks(maxEpicycles);  // Chain at the two latest simulation ticks
+    // Pen and curve time at this frame's ticks, sized for the longest frame: the
+    // stall cap in a window, the fixed step headless (plus the carried fraction)
+    const float maxFrameTime = 0.25f;  // Seconds
+    std::vector<std::pair<Point2D, double>> tickTips;
+    tickTips.reserve(static_cast<std::size_t>(
+        std::ceil((window ? maxFrameTime : options.timeStep) * fourierEngine.getTickRate())) + 1);
+
+    // Full reconstructed outline, resampled whenever the shape or epicycle count changes
+    std::vector<Point2D> outline(512);
+    bool outlineDirty = true;
 
     // Track drawing state
     bool wasDrawing = false;
 
     // Animation state
     bool paused = false;
-    float speed = 0.3f;  // Animation speed multiplier
-    int numEpicyclesToShow = 100;  // Number of epicycles to display
+    float speed = options.speed;  // Animation speed multiplier
+    int numEpicyclesToShow = std::max(1, std::min(options.epicycles, maxEpicycles));  // Number of epicycles to display
+    fourierEngine.setNumEpicycles(numEpicyclesToShow);
+    fourierEngine.setTopK(maxEpicycles);  // Never draws more, so sort no further up front
 
     // Visibility toggles
     bool showEpicycles = true;
     bool showTrail = true;
-
-    // Current shape name
-    std::string currentShapeName = "Circle";
-
-    // Main loop
-    while (window.isOpen()) {
-        // Delta time with cap to prevent huge jumps
-        float deltaTime = clock.restart().asSeconds();
-        if (deltaTime > 0.033f) deltaTime = 0.033f;  // cap at ~30 FPS worth
-        if (!paused) {
-            time += deltaTime * speed;
+    bool showOutline = false;
+    bool showProfiler = false;
+
+    // Per-stage frame timing; only reads the clock while the overlay or a trace is on
+    Profiler profiler;
+    if (!options.traceFile.empty()) profiler.startTrace();
+
+    // UI labels, rebuilt only when the state they show changes
+    std::string speedText, pauseText, epicycleText, trailText;
+    bool labelsDirty = true;
+    int shownCulledCircles = 0;
+    bool shownComputing = false;
+    const std::string helpText = "1-5: Shapes  |  Draw: Click & Drag  |  +/- Speed  |  [/] Epicycles  |  E: Toggle Epicycles  |  T: Toggle Trail  |  L: Loop Trail  |  O: Outline  |  Space: Pause  |  C: Clear  |  R: Reset  |  P: Profiler";
+
+    // Steady-state allocation check (only counts with FOURIER_TRACK_ALLOCATIONS)
+    const int allocationWarmupFrames = 120;
+    const int allocationReportFrames = 300;
+    int frameCount = 0;
+    std::size_t allocationsAtReport = 0;
+
+    // Main loop: until the window closes, or until the requested frame count headless
+    int framesRendered = 0;
+    while (window ? window->isOpen() : framesRendered < options.frames) {
+        ProfileScope frameZone(profiler, ProfileZone::Frame);
+
+        // Frame time feeds the engine's fixed-step clock. Headless runs use a fixed
+        // step and run as fast as frames render; a stall (dragging the window)
+        // is capped so it doesn't turn into a burst of ticks.
+        float deltaTime;
+        if (window) {
+            deltaTime = clock.restart().asSeconds();
+            if (deltaTime > maxFrameTime) deltaTime = maxFrameTime;
+        } else {
+            deltaTime = options.timeStep;
+        }
+        if (!paused && !scene) {
+            fourierEngine.accumulate(deltaTime);  // The scene keeps its own clocks
         }
 
-        // Handle events
-        while (const std::optional event = window.pollEvent()) {
+        // Handle events (windowed only)
+        ProfileScope eventsZone(profiler, ProfileZone::Events);
+        bool presetLoaded = false;  // A built-in shape replaced the coefficients
+        while (const std::optional event = window ? window->pollEvent() : std::nullopt) {
             if (event->is<sf::Event::Closed>()) {
-                window.close();
+                window->close();
             }
 
             // Handle input (mouse drawing)
-            inputHandler.handleEvent(*event, window);
+            inputHandler.handleEvent(*event, *window);
 
             // Handle keyboard input
             if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-                bool shapeChanged = false;
-
-                if (keyPressed->code == sf::Keyboard::Key::Num1) {
-                    // Circle
-                    path = PathData::createCircle(100, 120.f);
-                    currentShapeName = "Circle";
-                    shapeChanged = true;
-                    std::cout << "Shape: Circle" << std::endl;
-                }
-                else if (keyPressed->code == sf::Keyboard::Key::Num2) {
-                    // Square
-                    path = PathData::createSquare(200, 250.f);
-                    currentShapeName = "Square";
-                    shapeChanged = true;
-                    std::cout << "Shape: Square" << std::endl;
-                }
-                else if (keyPressed->code == sf::Keyboard::Key::Num3) {
-                    // Star
-                    path = PathData::createStar(200, 5, 120.f);
-                    currentShapeName = "Star";
-                    shapeChanged = true;
-                    std::cout << "Shape: Star" << std::endl;
-                }
-                else if (keyPressed->code == sf::Keyboard::Key::Num4) {
-                    // Heart
-                    path = PathData::createHeart(200, 10.f);
-                    currentShapeName = "Heart";
-                    shapeChanged = true;
-                    std::cout << "Shape: Heart" << std::endl;
-                }
-                else if (keyPressed->code == sf::Keyboard::Key::Num5) {
-                    // Infinity
-                    path = PathData::createInfinity(200, 120.f);
-                    currentShapeName = "Infinity";
-                    shapeChanged = true;
-                    std::cout << "Shape: Infinity" << std::endl;
+                labelsDirty = true;
+
+                if (!scene && keyPressed->code >= sf::Keyboard::Key::Num1 && keyPressed->code <= sf::Keyboard::Key::Num5) {
+                    // Circle, Square, Star, Heart, Infinity: a table copy, no transform
+                    const PresetShape& preset = Presets::get(static_cast<int>(keyPressed->code) - static_cast<int>(sf::Keyboard::Key::Num1) + 1);
+                    fourierEngine.loadPreset(preset);
+                    currentShapeName = preset.name;
+                    presetLoaded = true;
+                    std::cout << "Shape: " << currentShapeName << std::endl;
                 }
-                else if (keyPressed->code == sf::Keyboard::Key::C) {
+                else if (!scene && keyPressed->code == sf::Keyboard::Key::C) {
                     // Clear drawing and reset to circle
                     inputHandler.clearPath();
-                    path = PathData::createCircle(100, 120.f);
-                    currentShapeName = "Circle";
-                    fourierEngine.computeDFT(path);
-                    trail.clear();
-                    time = 0.f;
+                    fourierEngine.loadPreset(Presets::get(1));
+                    currentShapeName = Presets::get(1).name;
+                    presetLoaded = true;
                     std::cout << "Cleared - back to circle" << std::endl;
                 }
                 else if (keyPressed->code == sf::Keyboard::Key::R) {
                     // Reset animation
                     trail.clear();
-                    time = 0.f;
+                    loopTrail.clear();
+                    if (scene) scene->reset();
+                    fourierEngine.resetClock();
+                    ticks.stale = true;
                     std::cout << "Reset animation" << std::endl;
                 }
                 else if (keyPressed->code == sf::Keyboard::Key::Space) {
@@ -160,11 +378,15 @@ int main() {
                     // Adjust epicycle count with [ and ] keys
                     if (keyPressed->code == sf::Keyboard::Key::RBracket) {
                         numEpicyclesToShow += 10;
-                        if (numEpicyclesToShow > 200) numEpicyclesToShow = 200;  // Max epicycles
+                        if (numEpicyclesToShow > maxEpicycles) numEpicyclesToShow = maxEpicycles;  // Max epicycles
                     } else {
                         numEpicyclesToShow -= 10;
                         if (numEpicyclesToShow < 1) numEpicyclesToShow = 1;  // Min epicycles
                     }
+                    fourierEngine.setNumEpicycles(numEpicyclesToShow);
+                    outlineDirty = true;
+                    ticks.stale = true;
+                    loopTrail.clear();  // The curve changed shape
                     std::cout << "Epicycles: " << numEpicyclesToShow << std::endl;
                 }
                 else if (keyPressed->code == sf::Keyboard::Key::E) {
@@ -177,170 +399,254 @@ int main() {
                     showTrail = !showTrail;
                     std::cout << "Trail: " << (showTrail ? "Visible" : "Hidden") << std::endl;
                 }
-
-                if (shapeChanged) {
-                    fourierEngine.computeDFT(path);
-                    trail.clear();
-                    time = 0.f;
+                else if (keyPressed->code == sf::Keyboard::Key::L) {
+                    // Switch between the fading trail and one full period of the curve
+                    showLoop = !showLoop;
+                    loopTrail.clear();
+                    std::cout << "Trail mode: " << (showLoop ? "Loop" : "Fading") << std::endl;
+                }
+                else if (keyPressed->code == sf::Keyboard::Key::O) {
+                    // Toggle full outline visibility
+                    showOutline = !showOutline;
+                    std::cout << "Outline: " << (showOutline ? "Visible" : "Hidden") << std::endl;
+                }
+                else if (keyPressed->code == sf::Keyboard::Key::P) {
+                    // Toggle the profiler overlay (timing only runs while it is shown)
+                    showProfiler = !showProfiler;
+                    profiler.setEnabled(showProfiler);
+                    std::cout << "Profiler: " << (showProfiler ? "Visible" : "Hidden") << std::endl;
                 }
             }
         }
 
         // Check if user just finished drawing
-        if (wasDrawing && !inputHandler.isDrawing()) {
+        if (!scene && wasDrawing && !inputHandler.isDrawing()) {
             const auto& drawnPath = inputHandler.getDrawnPath();
-            if (drawnPath.size() > 10) {  // Only if they drew enough points
-                // Resample and center the path around origin
-                path = PathData::resamplePath(drawnPath, 200);
+            if (drawnPath.size() > 10) {  // Only strokes over ~10 px (samples are >= 1 px apart)
+                // The stroke was resampled while drawing. Simplify it, then take as
+                // few FFT-friendly points as keep it within tolerance (half the
+                // budget each), so the transform is no larger than the shape needs
+                float halfTolerance = 0.5f * std::max(options.tolerance, 0.01f);
+                std::vector<Point2D> simplified = PathData::simplifyPath(drawnPath, halfTolerance);
+                path = PathData::resamplePath(simplified, PathData::chooseSampleCount(simplified, halfTolerance));
                 path = PathData::centerPath(path, Point2D(0.f, 0.f));
 
-                // Compute Fourier transform
-                fourierEngine.computeDFT(path);
+                // Compute Fourier transform in the background
+                fourierEngine.submitPath(path);
                 currentShapeName = "Custom";
-                trail.clear();
-                time = 0.f;
-
-                std::cout << "Computed DFT from drawn shape!" << std::endl;
             }
         }
         wasDrawing = inputHandler.isDrawing();
-
-        // Get epicycles from Fourier Engine
-        std::vector<Epicycle> epicycles = fourierEngine.getEpicycles(time);
-
-        // Limit to the number user wants to see
-        if (epicycles.size() > static_cast<size_t>(numEpicyclesToShow)) {
-            epicycles.resize(numEpicyclesToShow);
+        eventsZone.stop();
+
+        // Pick up a finished transform; the previous shape animates until then.
+        // Long paths arrive as coarse previews first and refine without restarting.
+        ProfileScope transformZone(profiler, ProfileZone::Transform);
+        if (fourierEngine.acquireLatest() || presetLoaded) {
+            outlineDirty = true;
+            labelsDirty = true;
+            if (!fourierEngine.isRefinement()) {
+                trail.clear();
+                fourierEngine.resetClock();
+            }
+            loopTrail.clear();
+            ticks.stale = true;
+            if (fourierEngine.isExact() && !presetLoaded) {
+                std::cout << "DFT ready: " << currentShapeName << std::endl;
+            }
         }
-
-        // Assign colors to epicycles - spread across visible ones
-        for (size_t i = 0; i < epicycles.size(); i++) {
-            // Use a better distribution that spreads colors across visible epicycles
-            float t = static_cast<float>(i) / std::min(static_cast<int>(epicycles.size()), 5);
-            t = std::min(t, 1.0f);  // Clamp to 1.0
-
-            // Apply gradient: Pink -> Cyan -> Purple
-            sf::Color color;
-            if (t < 0.5f) {
-                color = lerpColor(
-                    sf::Color(255, 110, 199),  // Neon Pink
-                    sf::Color(0, 240, 255),    // Cyan
-                    t * 2.0f
-                );
-            } else {
-                color = lerpColor(
-                    sf::Color(0, 240, 255),    // Cyan
-                    sf::Color(185, 103, 255),  // Purple
-                    (t - 0.5f) * 2.0f
-                );
+        if (fourierEngine.isComputing() != shownComputing) {
+            shownComputing = !shownComputing;
+            labelsDirty = true;
+        }
+        transformZone.stop();
+
+        // Fixed simulation ticks: the chain is evaluated at every tick and the pen
+        // kept for the trail, so the trail comes out the same at any frame rate
+        ProfileScope evaluateZone(profiler, ProfileZone::Evaluate);
+        tickTips.clear();
+        if (!scene) {
+            while (fourierEngine.step(speed)) {
+                fourierEngine.evaluateTick(screenCenter, ticks);
+                tickTips.emplace_back(ticks.latestTip(), fourierEngine.getTime());
             }
-
-            epicycles[i].color = color;
+            if (ticks.stale) fourierEngine.evaluateTick(screenCenter, ticks);
         }
 
-        // Position epicycles relative to screen center and chain them together
-        Point2D currentPos = screenCenter;
-        for (size_t i = 0; i < epicycles.size(); i++) {
-            // Calculate rotation angle for this epicycle: angle = frequency * 2π * time + phase
-            float angle = 2.0f * M_PI * epicycles[i].frequency * time + epicycles[i].phase;
-            Point2D offset(
-                epicycles[i].radius * std::cos(angle),
-                epicycles[i].radius * std::sin(angle)
-            );
-
-            // Set epicycle center and move to next position
-            epicycles[i].center = currentPos;
-            currentPos.x += offset.x;
-            currentPos.y += offset.y;
+        // Get the visible epicycles from Fourier Engine, already chained from the screen
+        // center and drawn between the last two ticks; the pen sits where the last
+        // visible arm ends. Stays within capacity.
+        Point2D currentPos;
+        if (scene) {
+            // Every drawing of the scene, spread across the thread pool
+            scene->update(paused ? 0.0 : deltaTime, speed);
+            epicycles.clear();
+        } else {
+            epicycles.resize(maxEpicycles);
+            int visibleEpicycles;
+            currentPos = fourierEngine.interpolateTicks(ticks, epicycles.data(), visibleEpicycles);
+            epicycles.resize(visibleEpicycles);
+
+            // Assign colors to epicycles - spread across visible ones
+            Renderer::colorEpicycles(epicycles.data(), visibleEpicycles);
         }
 
-        // The final position is where we draw the trail
-        trail.push_back(currentPos);
+        evaluateZone.stop();
 
-        // Limit trail length
-        if (trail.size() > maxTrailLength) {
-            trail.erase(trail.begin());
+        // Offer every tick's pen position to the trail (the oldest chunk drops off
+        // when full; the loop trail stops after one period)
+        ProfileScope trailZone(profiler, ProfileZone::Trail);
+        for (const std::pair<Point2D, double>& tip : tickTips) {
+            (showLoop ? loopTrail : trail).add(tip.first, tip.second);
         }
+        trailZone.stop();
 
         // Clear with deep black background (vaporwave aesthetic)
-        window.clear(sf::Color(10, 10, 10));  // #0a0a0a
+        ProfileScope renderZone(profiler, ProfileZone::Render);
+        target->clear(sf::Color(10, 10, 10));  // #0a0a0a
+        renderer.beginFrame();
+
+        if (scene) {
+            scene->draw(*target, renderer, showEpicycles, showTrail);
+        } else {
+            // Draw the whole reconstructed curve (if visible)
+            if (showOutline) {
+                if (outlineDirty) {
+                    fourierEngine.sampleCurve(outline.data(), static_cast<int>(outline.size()));
+                    outlineDirty = false;
+                }
+                renderer.drawOutline(*target, outline, screenCenter);
+            }
 
-        // Draw trail (if visible)
-        if (showTrail) {
-            renderer.drawTrail(window, trail);
-        }
+            // Draw trail (if visible)
+            if (showTrail) {
+                renderer.drawTrail(*target, showLoop ? loopTrail : trail);
+            }
 
-        // Draw user's drawn path if they're drawing
-        if (inputHandler.isDrawing() && inputHandler.getDrawnPath().size() > 0) {
-            renderer.drawUserPath(window, inputHandler.getDrawnPath());
-        }
+            // Draw user's drawn path if they're drawing
+            if (inputHandler.isDrawing() && inputHandler.getDrawnPath().size() > 0) {
+                renderer.drawUserPath(*target, inputHandler.getDrawnPath());
+            }
+
+            // Draw epicycles (if visible)
+            if (showEpicycles) {
+                // Draw connecting lines between epicycles (each arm ends at the next center)
+                renderer.drawArms(*target, epicycles, currentPos);
 
-        // Draw epicycles (if visible)
-        if (showEpicycles) {
-            // Draw connecting lines between epicycles
-            Point2D lineStart = screenCenter;
-            for (size_t i = 0; i < epicycles.size(); i++) {
-                // Use same angle calculation as epicycle positioning: angle = frequency * 2π * time + phase
-                float angle = 2.0f * M_PI * epicycles[i].frequency * time + epicycles[i].phase;
-                Point2D offset(
-                    epicycles[i].radius * std::cos(angle),
-                    epicycles[i].radius * std::sin(angle)
-                );
-                Point2D lineEnd(lineStart.x + offset.x, lineStart.y + offset.y);
-
-                // Make connecting lines subtle
-                sf::Color subtleColor = epicycles[i].color;
-                subtleColor.a = 150;  // Add transparency
-
-                // Draw connecting arm
-                sf::Vertex line[2];
-                line[0].position = lineStart.toSFML();
-                line[0].color = subtleColor;
-                line[1].position = lineEnd.toSFML();
-                line[1].color = subtleColor;
-                window.draw(line, 2, sf::PrimitiveType::Lines);
-
-                lineStart = lineEnd;
+                // Draw epicycles
+                renderer.drawEpicycles(*target, epicycles);
             }
 
-            // Draw epicycles
-            renderer.drawEpicycles(window, epicycles);
+            // Draw glow at the drawing point
+            if (!epicycles.empty()) {
+                renderer.drawGlow(*target, currentPos);
+            }
         }
 
-        // Draw glow at the drawing point
-        if (!epicycles.empty()) {
-            renderer.drawGlow(window, currentPos);
+        renderZone.stop();
+
+        // Draw UI (the epicycle label also shows how many sub-pixel circles were culled)
+        ProfileScope uiZone(profiler, ProfileZone::UI);
+        int culledCircles = renderer.getStats().circlesCulled;
+        if (culledCircles != shownCulledCircles) {
+            shownCulledCircles = culledCircles;
+            labelsDirty = true;
+        }
+        if (labelsDirty) {
+            speedText = "Speed: " + std::to_string(speed).substr(0, 3) + "x";
+            pauseText = paused ? "[PAUSED]" : "[Playing]";
+            if (shownComputing) pauseText += fourierEngine.isExact() ? " Computing..." : " Refining...";
+            epicycleText = "Epicycles: " + std::to_string(fourierEngine.getActiveEpicycles()) + (showEpicycles ? "" : " [Hidden]");
+            if (showEpicycles && culledCircles > 0) {
+                epicycleText += " (" + std::to_string(culledCircles) + " culled)";
+            }
+            trailText = "Trail: " + std::string(showTrail ? (showLoop ? "Loop" : "Visible") : "Hidden");
+            labelsDirty = false;
         }
 
-        // Draw UI
         // Top-left panel for animation controls
-        uiManager.drawPanel(window, 5, 5, 240, 75);
-        uiManager.drawText(window, "ANIMATION", 15, 10, 12);
-        std::string speedText = "Speed: " + std::to_string(speed).substr(0, 3) + "x";
-        uiManager.drawText(window, speedText, 15, 30);
-        std::string pauseText = paused ? "[PAUSED]" : "[Playing]";
-        uiManager.drawText(window, pauseText, 15, 50);
+        uiManager.drawPanel(*target, 5, 5, 240, 75);
+        uiManager.drawText(*target, "ANIMATION", 15, 10, 12);
+        uiManager.drawText(*target, speedText, 15, 30);
+        uiManager.drawText(*target, pauseText, 15, 50);
 
         // Top-middle panel for rendering controls
-        uiManager.drawPanel(window, 250, 5, 280, 75);
-        uiManager.drawText(window, "RENDERING", 260, 10, 12);
-        std::string epicycleText = "Epicycles: " + std::to_string(numEpicyclesToShow) + (showEpicycles ? "" : " [Hidden]");
-        uiManager.drawText(window, epicycleText, 260, 30);
-        std::string trailText = "Trail: " + std::string(showTrail ? "Visible" : "Hidden");
-        uiManager.drawText(window, trailText, 260, 50);
+        uiManager.drawPanel(*target, 250, 5, 280, 75);
+        uiManager.drawText(*target, "RENDERING", 260, 10, 12);
+        uiManager.drawText(*target, epicycleText, 260, 30);
+        uiManager.drawText(*target, trailText, 260, 50);
 
         // Top-right panel for shape info
-        uiManager.drawPanel(window, 535, 5, 200, 75);
-        uiManager.drawText(window, "SHAPE", 545, 10, 12);
-        uiManager.drawText(window, currentShapeName, 545, 30);
+        uiManager.drawPanel(*target, 535, 5, 200, 75);
+        uiManager.drawText(*target, "SHAPE", 545, 10, 12);
+        uiManager.drawText(*target, currentShapeName, 545, 30);
 
         // Bottom panel for help text
-        uiManager.drawPanel(window, 5, 682, 1270, 30);
-        uiManager.drawText(window, "1-5: Shapes  |  Draw: Click & Drag  |  +/- Speed  |  [/] Epicycles  |  E: Toggle Epicycles  |  T: Toggle Trail  |  Space: Pause  |  C: Clear  |  R: Reset", 10, 690);
+        uiManager.drawPanel(*target, 5, height - 38, width - 10, 30);
+        uiManager.drawText(*target, helpText, 10, height - 30);
+
+        // Stage timings below the animation panel
+        if (showProfiler) {
+            uiManager.drawProfiler(*target, profiler, 5, 85);
+        }
+        uiZone.stop();
+
+        // Display, or hand the finished frame to the PNG writer thread
+        ProfileScope presentZone(profiler, ProfileZone::Present);
+        if (window) {
+            window->display();
+        } else {
+            canvas->display();
+            frameWriter->submit(canvas->getTexture().copyToImage());
+        }
+        presentZone.stop();
+        framesRendered++;
+
+        // Report heap allocations once the loop has warmed up; steady frames should show 0
+        if (AllocationCounter::enabled()) {
+            frameCount++;
+            if (frameCount == allocationWarmupFrames) {
+                allocationsAtReport = AllocationCounter::count();
+            } else if (frameCount > allocationWarmupFrames &&
+                       (frameCount - allocationWarmupFrames) % allocationReportFrames == 0) {
+                std::size_t allocations = AllocationCounter::count() - allocationsAtReport;
+                std::cout << "Heap allocations in last " << allocationReportFrames
+                          << " frames: " << allocations << std::endl;
+                allocationsAtReport = AllocationCounter::count();
+            }
+        }
+    }
 
-        // Display
-        window.display();
+    if (profiler.isTracing()) {
+        if (profiler.writeTrace(options.traceFile)) {
+            std::cout << "Wrote frame trace to " << options.traceFile << std::endl;
+        } else {
+            std::cerr << "Failed to write frame trace to " << options.traceFile << std::endl;
+        }
+    }
+
+    if (frameWriter) {
+        frameWriter->finish();
+        std::cout << "Wrote " << frameWriter->getFramesWritten() << " frames to "
+                  << frameWriter->getDirectory() << std::endl;
+        if (frameWriter->getFailures() > 0) return 1;
     }
 
     return 0;
 }
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // Float keeps the window realtime; exported frames are worth double's accuracy
+    bool useDouble = options.precision.empty() ? options.headless : options.precision == "double";
+    if (useDouble) {
+        std::cout << "Evaluating epicycles in " << DoublePrecision::NAME << std::endl;
+        return runVisualizer<DoublePrecision>(options);
+    }
+    std::cout << "Evaluating epicycles in " << SinglePrecision::NAME << std::endl;
+    return runVisualizer<SinglePrecision>(options);
+}